@@ -9,7 +9,9 @@
 *
 * License: BSD
 *********************************/
+#include <limits>
 #include "ast.h"
+#include "memstats.h"
 
 namespace llvmpascal
 {
@@ -17,12 +19,56 @@ namespace llvmpascal
         : loc_(loc)
     {}
 
-    BlockAST::BlockAST(const TokenLocation& loc, const VecExprASTPtr& body)
-        : ExprAST(loc), body_(body)
+    void* ExprAST::operator new(std::size_t size)
+    {
+        MemoryStats::allocate(MemoryCategory::AST, size);
+        return ::operator new(size);
+    }
+
+    void ExprAST::operator delete(void* ptr, std::size_t size)
+    {
+        MemoryStats::deallocate(MemoryCategory::AST, size);
+        ::operator delete(ptr);
+    }
+
+    BlockAST::BlockAST(const TokenLocation& loc, VecExprASTPtr body)
+        : ExprAST(loc), body_(std::move(body))
+    {}
+
+    ProgramAST::ProgramAST(const TokenLocation& loc, const std::string& programName,
+        std::vector<std::string> usedUnits)
+        : ExprAST(loc), programName_(programName), usedUnits_(std::move(usedUnits))
+    {}
+
+    UnitAST::UnitAST(const TokenLocation& loc, const std::string& unitName,
+        std::vector<std::string> interfaceUses, std::vector<std::string> implementationUses)
+        : ExprAST(loc), unitName_(unitName), interfaceUses_(std::move(interfaceUses)),
+        implementationUses_(std::move(implementationUses))
     {}
 
-    ProgramAST::ProgramAST(const TokenLocation& loc, const std::string& programName)
-        : ExprAST(loc), programName_(programName)
+    IntegerExprAST::IntegerExprAST(const TokenLocation& loc, long value)
+        : ExprAST(loc), value_(value)
+    {}
+
+    RealExprAST::RealExprAST(const TokenLocation& loc, double value)
+        : ExprAST(loc), value_(value)
+    {}
+
+    CharExprAST::CharExprAST(const TokenLocation& loc, char value)
+        : ExprAST(loc), value_(value)
+    {}
+
+    StringExprAST::StringExprAST(const TokenLocation& loc, const std::string& value)
+        : ExprAST(loc), value_(value)
+    {}
+
+    BinaryExprAST::BinaryExprAST(const TokenLocation& loc, TokenValue op, ExprASTPtr lhs, ExprASTPtr rhs)
+        : ExprAST(loc), op_(op), lhs_(std::move(lhs)), rhs_(std::move(rhs))
+    {}
+
+    SetExpressionAST::SetExpressionAST(const TokenLocation& loc, const PascalSet& constantMembers,
+        std::vector<MemberRange> members)
+        : ExprAST(loc), constantMembers_(constantMembers), members_(std::move(members))
     {}
 
     IfStatementAST::IfStatementAST(const TokenLocation& loc, ExprASTPtr condition, ExprASTPtr thenPart, ExprASTPtr elsePart)
@@ -34,11 +80,139 @@ namespace llvmpascal
     {}
 
     ForStatementAST::ForStatementAST(const TokenLocation& loc, const std::string& controlVariable,
-        ExprASTPtr startExpr, ExprASTPtr endExpr, bool downOrder, ExprASTPtr body)
+        ExprASTPtr startExpr, ExprASTPtr endExpr, bool downOrder, ExprASTPtr body,
+        RangeCheckKind rangeCheck, const ValueRange& controlRange)
         : ExprAST(loc), controlVariable_(controlVariable), startExpr_(std::move(startExpr)),
-        endExpr_(std::move(endExpr)), downOrder_(downOrder), body_(std::move(body))
+        endExpr_(std::move(endExpr)), downOrder_(downOrder), body_(std::move(body)),
+        rangeCheck_(rangeCheck), controlRange_(controlRange)
+    {}
+
+    bool ForStatementAST::getConstantTripCount(unsigned long& tripCount) const
+    {
+        ValueRange startRange;
+        ValueRange endRange;
+
+        if (!RangeCheck::evaluateRange(startExpr_.get(), startRange) ||
+            !RangeCheck::evaluateRange(endExpr_.get(), endRange))
+        {
+            return false;
+        }
+
+        long first = startRange.low;
+        long last = endRange.low;
+
+        if (downOrder_)
+        {
+            std::swap(first, last);
+        }
+
+        if (first > last)
+        {
+            tripCount = 0;
+            return true;
+        }
+
+        // unsigned subtraction, so -maxint..maxint does not overflow,
+        // but the + 1 wraps to 0 for the whole range of long.
+        unsigned long distance = static_cast<unsigned long>(last) - static_cast<unsigned long>(first);
+
+        if (distance == std::numeric_limits<unsigned long>::max())
+        {
+            return false;
+        }
+
+        tripCount = distance + 1;
+        return true;
+    }
+
+    CaseStatementAST::CaseStatementAST(const TokenLocation& loc, ExprASTPtr caseIndex, CaseLowering lowering,
+        VecExprASTPtr arms, ExprASTPtr otherwisePart)
+        : ExprAST(loc), caseIndex_(std::move(caseIndex)), lowering_(std::move(lowering)),
+        arms_(std::move(arms)), otherwisePart_(std::move(otherwisePart))
     {}
 
+    WriteStatementAST::WriteStatementAST(const TokenLocation& loc, bool newLine, std::vector<WriteArgument> arguments)
+        : ExprAST(loc), newLine_(newLine), arguments_(std::move(arguments))
+    {}
+
+    // the type of one expression, as far as we know it without symbol table.
+    // see pascal standard 6.7.2.2 for the result types of the arithmetic operators.
+    WriteArgumentKind WriteStatementAST::getArgumentKind(const ExprAST* expr)
+    {
+        if (dynamic_cast<const IntegerExprAST*>(expr) != nullptr)
+        {
+            return WriteArgumentKind::INTEGER;
+        }
+
+        if (dynamic_cast<const RealExprAST*>(expr) != nullptr)
+        {
+            return WriteArgumentKind::REAL;
+        }
+
+        if (dynamic_cast<const CharExprAST*>(expr) != nullptr)
+        {
+            return WriteArgumentKind::CHAR;
+        }
+
+        if (dynamic_cast<const StringExprAST*>(expr) != nullptr)
+        {
+            return WriteArgumentKind::STRING;
+        }
+
+        auto binaryExpr = dynamic_cast<const BinaryExprAST*>(expr);
+
+        if (binaryExpr == nullptr)
+        {
+            return WriteArgumentKind::UNKNOWN;
+        }
+
+        switch (binaryExpr->getOp())
+        {
+            case TokenValue::EQUAL:
+            case TokenValue::NOT_EQUAL:
+            case TokenValue::LESS_THAN:
+            case TokenValue::LESS_OR_EQUAL:
+            case TokenValue::GREATER_THAN:
+            case TokenValue::GREATER_OR_EQUAL:
+            case TokenValue::IN:
+                return WriteArgumentKind::BOOLEAN;
+
+            default:
+                break;
+        }
+
+        WriteArgumentKind lhs = getArgumentKind(binaryExpr->getLHS());
+        WriteArgumentKind rhs = getArgumentKind(binaryExpr->getRHS());
+        bool lhsNumber = lhs == WriteArgumentKind::INTEGER || lhs == WriteArgumentKind::REAL;
+        bool rhsNumber = rhs == WriteArgumentKind::INTEGER || rhs == WriteArgumentKind::REAL;
+
+        switch (binaryExpr->getOp())
+        {
+            case TokenValue::PLUS:
+            case TokenValue::MINUS:
+            case TokenValue::MULTIPLY:
+                if (lhsNumber && rhsNumber)
+                {
+                    return lhs == WriteArgumentKind::INTEGER && rhs == WriteArgumentKind::INTEGER ?
+                           WriteArgumentKind::INTEGER : WriteArgumentKind::REAL;
+                }
+
+                return WriteArgumentKind::UNKNOWN;
+
+            case TokenValue::DIVIDE:
+                return lhsNumber && rhsNumber ? WriteArgumentKind::REAL : WriteArgumentKind::UNKNOWN;
+
+            // 6.7.2.2 div and mod are only defined for integer operands.
+            case TokenValue::DIV:
+            case TokenValue::MOD:
+                return lhs == WriteArgumentKind::INTEGER && rhs == WriteArgumentKind::INTEGER ?
+                       WriteArgumentKind::INTEGER : WriteArgumentKind::UNKNOWN;
+
+            default:
+                return WriteArgumentKind::UNKNOWN;
+        }
+    }
+
     RepeatStatementAST::RepeatStatementAST(const TokenLocation& loc, ExprASTPtr condition, BlockASTPtr body)
         : ExprAST(loc), condition_(std::move(condition)), body_(std::move(body))
     {}
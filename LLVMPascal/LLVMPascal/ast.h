@@ -13,10 +13,16 @@
 #ifndef AST_H_
 #define AST_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
+#include <utility>
 #include "token.h"
+#include "caselowering.h"
+#include "pascalset.h"
+#include "rangecheck.h"
 
 namespace llvmpascal
 {
@@ -53,32 +59,204 @@ namespace llvmpascal
         ExprAST(const TokenLocation& loc);
         virtual       ~ExprAST() = default;
 
+        // count AST memory for -fmem-report.
+        static void*  operator new(std::size_t size);
+        static void   operator delete(void* ptr, std::size_t size);
+
     private:
         TokenLocation loc_;
 
     };
 
+    // program heading and its uses clause. Like the uses clauses of
+    // UnitAST, the used units must be compiled before the program.
     class ProgramAST : public ExprAST
     {
     public:
-        explicit      ProgramAST(const TokenLocation& loc, const std::string& programName);
+        ProgramAST(const TokenLocation& loc, const std::string& programName,
+            std::vector<std::string> usedUnits);
+        const std::string&               getProgramName() const;
+        const std::vector<std::string>&  getUsedUnits() const;
 
     private:
-        std::string   programName_;
+        std::string                      programName_;
+        std::vector<std::string>         usedUnits_;
     };
 
+    inline const std::string& ProgramAST::getProgramName() const
+    {
+        return programName_;
+    }
+
+    inline const std::vector<std::string>& ProgramAST::getUsedUnits() const
+    {
+        return usedUnits_;
+    }
+
+    // unit heading and its uses clauses. The units one unit uses are
+    // what it depends on, see Parser::parseUnit.
+    class UnitAST : public ExprAST
+    {
+    public:
+        UnitAST(const TokenLocation& loc, const std::string& unitName,
+            std::vector<std::string> interfaceUses, std::vector<std::string> implementationUses);
+        const std::string&               getUnitName() const;
+        const std::vector<std::string>&  getInterfaceUses() const;
+        const std::vector<std::string>&  getImplementationUses() const;
+
+    private:
+        std::string                      unitName_;
+        std::vector<std::string>         interfaceUses_;
+        std::vector<std::string>         implementationUses_;
+    };
+
+    inline const std::string& UnitAST::getUnitName() const
+    {
+        return unitName_;
+    }
+
+    inline const std::vector<std::string>& UnitAST::getInterfaceUses() const
+    {
+        return interfaceUses_;
+    }
+
+    inline const std::vector<std::string>& UnitAST::getImplementationUses() const
+    {
+        return implementationUses_;
+    }
+
     class VariableAST : public ExprAST
     {
 
     };
 
+    // literal values, such as 3, 3.14, 'a' and 'hello'.
+    class IntegerExprAST : public ExprAST
+    {
+    public:
+        IntegerExprAST(const TokenLocation& loc, long value);
+        long          getValue() const;
+
+    private:
+        long          value_;
+    };
+
+    class RealExprAST : public ExprAST
+    {
+    public:
+        RealExprAST(const TokenLocation& loc, double value);
+        double        getValue() const;
+
+    private:
+        double        value_;
+    };
+
+    class CharExprAST : public ExprAST
+    {
+    public:
+        CharExprAST(const TokenLocation& loc, char value);
+        char          getValue() const;
+
+    private:
+        char          value_;
+    };
+
+    class StringExprAST : public ExprAST
+    {
+    public:
+        StringExprAST(const TokenLocation& loc, const std::string& value);
+        const std::string& getValue() const;
+
+    private:
+        std::string   value_;
+    };
+
+    // lhs op rhs. op is the token value, such as TokenValue::PLUS or TokenValue::IN.
+    class BinaryExprAST : public ExprAST
+    {
+    public:
+        BinaryExprAST(const TokenLocation& loc, TokenValue op, ExprASTPtr lhs, ExprASTPtr rhs);
+        TokenValue    getOp() const;
+        const ExprAST* getLHS() const;
+        const ExprAST* getRHS() const;
+
+    private:
+        TokenValue    op_;
+        ExprASTPtr    lhs_;
+        ExprASTPtr    rhs_;
+    };
+
+    // set constructor, such as [1, 3..5, x, y..z].
+    // constant members are folded into one PascalSet when we parse them,
+    // others are kept as ranges (high is nullptr for a single member).
+    // so a constant set constructor needs no code at runtime.
+    class SetExpressionAST : public ExprAST
+    {
+    public:
+        using MemberRange = std::pair<ExprASTPtr, ExprASTPtr>;
+
+        SetExpressionAST(const TokenLocation& loc, const PascalSet& constantMembers,
+            std::vector<MemberRange> members);
+        const PascalSet& getConstantMembers() const;
+        bool          isConstant() const;
+
+    private:
+        PascalSet     constantMembers_;
+        std::vector<MemberRange> members_;
+    };
+
+    inline long IntegerExprAST::getValue() const
+    {
+        return value_;
+    }
+
+    inline double RealExprAST::getValue() const
+    {
+        return value_;
+    }
+
+    inline char CharExprAST::getValue() const
+    {
+        return value_;
+    }
+
+    inline const std::string& StringExprAST::getValue() const
+    {
+        return value_;
+    }
+
+    inline TokenValue BinaryExprAST::getOp() const
+    {
+        return op_;
+    }
+
+    inline const ExprAST* BinaryExprAST::getLHS() const
+    {
+        return lhs_.get();
+    }
+
+    inline const ExprAST* BinaryExprAST::getRHS() const
+    {
+        return rhs_.get();
+    }
+
+    inline const PascalSet& SetExpressionAST::getConstantMembers() const
+    {
+        return constantMembers_;
+    }
+
+    inline bool SetExpressionAST::isConstant() const
+    {
+        return members_.empty();
+    }
+
     class BlockAST : public ExprAST
     {
     public:
-        BlockAST(const TokenLocation& loc, const VecExprASTPtr& body);
+        BlockAST(const TokenLocation& loc, VecExprASTPtr body);
 
     private:
-        const VecExprASTPtr& body_;
+        VecExprASTPtr body_;
     };
 
     class FunctionAST : public ExprAST
@@ -118,11 +296,33 @@ namespace llvmpascal
 
     };
 
+    // rangeCheck tells how the control variable is checked, see rangecheck.h.
+    // controlRange is only valid if the check is eliminated.
+    //
+    // The bounds are evaluated once before the loop and the body can not
+    // modify the control variable (pascal standard 6.8.3.9), which C does
+    // not promise. So code generation (which we do not have yet) is meant to
+    // lower the loop as one canonical counted loop:
+    //
+    //     tripCount = to ? end - start + 1 : start - end + 1  (0 if empty)
+    //     for (n = 0; n != tripCount; ++n)  { v = start +/- n; body }
+    //
+    // Then the counter can be marked as not wrapping (nuw / nsw) and the loop
+    // can get llvm.loop vectorize / unroll metadata, so LLVM's vectorizer
+    // would need no runtime checks to find the iteration count.
     class ForStatementAST : public ExprAST
     {
     public:
         ForStatementAST(const TokenLocation& loc, const std::string& controlVariable, ExprASTPtr startExpr, ExprASTPtr endExpr,
-            bool downOrder, ExprASTPtr body);
+            bool downOrder, ExprASTPtr body, RangeCheckKind rangeCheck, const ValueRange& controlRange);
+        RangeCheckKind    getRangeCheck() const;
+        const ValueRange& getControlRange() const;
+        bool              isDownOrder() const;
+
+        // false if the bounds are not known at compile time, then the same
+        // formula is computed once at loop entry. Also false if the count does
+        // not fit unsigned long, i.e. the loop runs over the whole range of long.
+        bool              getConstantTripCount(unsigned long& tripCount) const;
 
     private:
         std::string controlVariable_;
@@ -130,9 +330,48 @@ namespace llvmpascal
         ExprASTPtr  endExpr_;
         bool        downOrder_;
         ExprASTPtr  body_;
+        RangeCheckKind rangeCheck_;
+        ValueRange  controlRange_;
+
+    };
+
+    inline RangeCheckKind ForStatementAST::getRangeCheck() const
+    {
+        return rangeCheck_;
+    }
+
+    inline const ValueRange& ForStatementAST::getControlRange() const
+    {
+        return controlRange_;
+    }
+
+    inline bool ForStatementAST::isDownOrder() const
+    {
+        return downOrder_;
+    }
 
+    // case-list-elements are kept in source order. Every label points to
+    // its element by CaseLabelRange::armIndex. The lowering (jump table,
+    // bit test, binary search) is decided here, see caselowering.h
+    class CaseStatementAST : public ExprAST
+    {
+    public:
+        CaseStatementAST(const TokenLocation& loc, ExprASTPtr caseIndex, CaseLowering lowering,
+            VecExprASTPtr arms, ExprASTPtr otherwisePart);
+        const CaseLowering& getLowering() const;
+
+    private:
+        ExprASTPtr    caseIndex_;
+        CaseLowering  lowering_;
+        VecExprASTPtr arms_;
+        ExprASTPtr    otherwisePart_;
     };
 
+    inline const CaseLowering& CaseStatementAST::getLowering() const
+    {
+        return lowering_;
+    }
+
     class RepeatStatementAST : public ExprAST
     {
     public:
@@ -144,6 +383,54 @@ namespace llvmpascal
 
     };
 
+    // which runtime routine one write parameter calls. It is decided
+    // when we parse, so code generation calls the routine of the type
+    // directly instead of one generic format interpreter.
+    enum class WriteArgumentKind : std::uint8_t
+    {
+        INTEGER,
+        REAL,
+        CHAR,
+        STRING,
+        BOOLEAN,
+        UNKNOWN        // variables, after we have symbol table
+    };
+
+    // write-parameter = expression [ ':' expression [ ':' expression ] ] .
+    // width and precision are nullptr if they are not given.
+    struct WriteArgument
+    {
+        ExprASTPtr        value;
+        ExprASTPtr        width;
+        ExprASTPtr        precision;
+        WriteArgumentKind kind;
+    };
+
+    // write / writeln, see pascal standard 6.9.3 and 6.9.4.
+    class WriteStatementAST : public ExprAST
+    {
+    public:
+        WriteStatementAST(const TokenLocation& loc, bool newLine, std::vector<WriteArgument> arguments);
+        bool                               isNewLine() const;
+        const std::vector<WriteArgument>&  getArguments() const;
+
+        static WriteArgumentKind           getArgumentKind(const ExprAST* expr);
+
+    private:
+        bool                               newLine_;
+        std::vector<WriteArgument>         arguments_;
+    };
+
+    inline bool WriteStatementAST::isNewLine() const
+    {
+        return newLine_;
+    }
+
+    inline const std::vector<WriteArgument>& WriteStatementAST::getArguments() const
+    {
+        return arguments_;
+    }
+
     class AssignStatementAST : public ExprAST
     {
     public:
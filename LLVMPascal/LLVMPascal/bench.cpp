@@ -0,0 +1,552 @@
+// Scanner and parser throughput benchmark. The output (both console and
+// --benchmark_out JSON) follows Google Benchmark, so the JSON can be compared
+// with its tools/compare.py script.
+//
+// Without input files, it measures the generated corpus (see corpusgen.h).
+// With input files, such as the workloads in bench/, every file is measured
+// --repetitions times and we report mean, standard deviation and 95%
+// confidence interval, and compare them with a --baseline JSON written by
+// one earlier run.
+//
+// Usage: lpc-bench [options] [file...], see printUsage.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "corpusgen.h"
+#include "parser.h"
+#include "scanner.h"
+using namespace llvmpascal;
+
+namespace
+{
+    struct BenchmarkResult
+    {
+        std::string name;
+        long        iterations;
+        double      secondsPerIteration;
+        double      bytesPerSecond;
+        double      itemsPerSecond;
+        std::string itemLabel;
+
+        // empty for one iteration result, otherwise mean / stddev / ci95.
+        std::string runName;
+        std::string aggregateName;
+    };
+
+    struct Statistics
+    {
+        double mean;
+        double stddev;
+        double ci95;
+    };
+
+    // parseConstantDefinition still dumps every constant to std::cout.
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) override
+        {
+            return c;
+        }
+    };
+
+    void printUsage()
+    {
+        std::cerr << "Usage: lpc-bench [options] [file...]\n"
+                  << "Options:\n"
+                  << "  --seed=<n>                  Generator seed\n"
+                  << "  --statements=<n>            Statements (constant definitions for the parser)\n"
+                  << "  --expression-density=<p>    Probability to add one more operator to an expression\n"
+                  << "  --nesting-depth=<n>         Max nesting depth of statements and parentheses\n"
+                  << "  --comment-ratio=<p>         Probability of a comment before a statement\n"
+                  << "  --identifiers=<n>           Distinct identifiers\n"
+                  << "  --literal-mix=<i,r,c,s>     Weights of integer, real, char and string literals\n"
+                  << "  --min-time=<seconds>        Minimum time of each benchmark (default: 0.5)\n"
+                  << "  --repetitions=<n>           Repetitions of each input file (default: 10)\n"
+                  << "  --baseline=<file>           Compare input file results with one earlier JSON\n"
+                  << "  --benchmark_out=<file>      Write results as JSON\n"
+                  << "  file...                     Measure these files instead of the generated corpus\n";
+    }
+
+    bool startsWith(const std::string& str, const std::string& prefix, std::string& value)
+    {
+        if (str.compare(0, prefix.size(), prefix) != 0)
+        {
+            return false;
+        }
+
+        value = str.substr(prefix.size());
+        return true;
+    }
+
+    bool writeFile(const std::string& fileName, const std::string& content)
+    {
+        std::ofstream output(fileName, std::ios::binary);
+        output << content;
+        return static_cast<bool>(output);
+    }
+
+    // run body until minTime is reached. body returns the items it handled.
+    BenchmarkResult runBenchmark(const std::string& name, const std::string& itemLabel,
+                                 std::size_t bytes, double minTime, const std::function<long()>& body)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // warm up the file cache and the allocator.
+        long items = body();
+        long iterations = 0;
+        auto start = Clock::now();
+        std::chrono::duration<double> elapsed(0);
+
+        do
+        {
+            body();
+            iterations++;
+            elapsed = Clock::now() - start;
+        } while (elapsed.count() < minTime);
+
+        double seconds = elapsed.count() / iterations;
+        return BenchmarkResult{ name, iterations, seconds, bytes / seconds, items / seconds, itemLabel, "", "" };
+    }
+
+    // two-sided 95% quantile of Student's t distribution.
+    double studentT95(std::size_t degrees)
+    {
+        static const double table[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+
+        if (degrees == 0)
+        {
+            return 0.0;
+        }
+
+        return degrees <= 30 ? table[degrees - 1] : 1.96;
+    }
+
+    Statistics computeStatistics(const std::vector<double>& samples)
+    {
+        double sum = 0.0;
+
+        for (double sample : samples)
+        {
+            sum += sample;
+        }
+
+        double mean = sum / samples.size();
+        double squares = 0.0;
+
+        for (double sample : samples)
+        {
+            squares += (sample - mean) * (sample - mean);
+        }
+
+        double stddev = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0.0;
+        double ci95 = studentT95(samples.size() - 1) * stddev / std::sqrt(static_cast<double>(samples.size()));
+
+        return Statistics{ mean, stddev, ci95 };
+    }
+
+    // read the mean time (ns) of every benchmark from one JSON we wrote before.
+    // it is not one general JSON parser, it only knows our own output.
+    std::map<std::string, double> readBaseline(const std::string& fileName)
+    {
+        std::map<std::string, double> baseline;
+        std::ifstream input(fileName);
+        std::string line;
+        std::string runName;
+        bool isMean = false;
+
+        while (std::getline(input, line))
+        {
+            std::string value;
+            auto begin = line.find_first_not_of(' ');
+
+            if (begin == std::string::npos)
+            {
+                continue;
+            }
+
+            line = line.substr(begin);
+
+            if (startsWith(line, "\"run_name\": \"", value))
+            {
+                runName = value.substr(0, value.find('"'));
+            }
+            else if (startsWith(line, "\"aggregate_name\": \"", value))
+            {
+                isMean = value.compare(0, 4, "mean") == 0;
+            }
+            else if (startsWith(line, "\"real_time\": ", value) && isMean)
+            {
+                baseline[runName] = std::strtod(value.c_str(), nullptr);
+                isMean = false;
+            }
+        }
+
+        return baseline;
+    }
+
+    // hello/world.pas -> world
+    std::string workloadName(const std::string& fileName)
+    {
+        auto slash = fileName.find_last_of("/\\");
+        std::string name = slash == std::string::npos ? fileName : fileName.substr(slash + 1);
+        return name.substr(0, name.find_last_of('.'));
+    }
+
+    void printResult(const BenchmarkResult& result)
+    {
+        std::cout << std::left << std::setw(28) << result.name << std::right << std::fixed
+                  << std::setw(12) << std::setprecision(3) << result.secondsPerIteration * 1e3 << " ms"
+                  << std::setw(10) << result.iterations
+                  << std::setw(12) << std::setprecision(2) << result.bytesPerSecond / (1024 * 1024) << " MB/s"
+                  << std::setw(14) << std::setprecision(0) << result.itemsPerSecond << " " << result.itemLabel << "/s"
+                  << std::endl;
+    }
+
+    // options is null when we measure input files, the corpus options mean nothing then.
+    bool writeJSON(const std::string& fileName, const CorpusOptions* options,
+                   const std::vector<BenchmarkResult>& results)
+    {
+        std::ofstream output(fileName);
+
+        if (!output)
+        {
+            return false;
+        }
+
+        std::time_t now = std::time(nullptr);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        output << "{\n  \"context\": {\n"
+               << "    \"date\": \"" << date << "\",\n"
+               << "    \"executable\": \"lpc-bench\"";
+
+        if (options)
+        {
+            output << ",\n"
+                   << "    \"seed\": " << options->seed << ",\n"
+                   << "    \"statements\": " << options->statementCount << ",\n"
+                   << "    \"expression_density\": " << options->expressionDensity << ",\n"
+                   << "    \"nesting_depth\": " << options->nestingDepth << ",\n"
+                   << "    \"comment_ratio\": " << options->commentRatio << ",\n"
+                   << "    \"identifiers\": " << options->identifierCount;
+        }
+
+        output << "\n  },\n  \"benchmarks\": [";
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const BenchmarkResult& result = results[i];
+            output << (i == 0 ? "\n" : ",\n")
+                   << "    {\n"
+                   << "      \"name\": \"" << result.name << "\",\n";
+
+            if (result.aggregateName.empty())
+            {
+                output << "      \"run_type\": \"iteration\",\n";
+            }
+            else
+            {
+                output << "      \"run_name\": \"" << result.runName << "\",\n"
+                       << "      \"run_type\": \"aggregate\",\n"
+                       << "      \"aggregate_name\": \"" << result.aggregateName << "\",\n";
+            }
+
+            output
+                   << "      \"iterations\": " << result.iterations << ",\n"
+                   << std::fixed << std::setprecision(1)
+                   << "      \"real_time\": " << result.secondsPerIteration * 1e9 << ",\n"
+                   << "      \"cpu_time\": " << result.secondsPerIteration * 1e9 << ",\n"
+                   << "      \"time_unit\": \"ns\",\n"
+                   << "      \"bytes_per_second\": " << result.bytesPerSecond << ",\n"
+                   << "      \"items_per_second\": " << result.itemsPerSecond << "\n"
+                   << "    }";
+        }
+
+        output << "\n  ]\n}\n";
+
+        return static_cast<bool>(output);
+    }
+
+    bool runCorpusBenchmarks(const CorpusOptions& options, double minTime, std::vector<BenchmarkResult>& results)
+    {
+        // the scanner reads files, so we write the corpus into the current directory.
+        const std::string scannerCorpus = "bench_scanner_corpus.pas";
+        const std::string parserCorpus = "bench_parser_corpus.pas";
+
+        CorpusGenerator scannerGenerator(options);
+        std::string scannerSource = scannerGenerator.generate();
+
+        CorpusOptions parserOptions = options;
+        parserOptions.parserSubset = true;
+        CorpusGenerator parserGenerator(parserOptions);
+        std::string parserSource = parserGenerator.generate();
+        long parserStatements = parserGenerator.getStatementCount();
+
+        if (!writeFile(scannerCorpus, scannerSource) || !writeFile(parserCorpus, parserSource))
+        {
+            std::cerr << "lpc-bench: can not write corpus files" << std::endl;
+            return false;
+        }
+
+        std::cout << "Scanner corpus: " << scannerSource.size() << " bytes, "
+                  << scannerGenerator.getStatementCount() << " statements\n"
+                  << "Parser corpus:  " << parserSource.size() << " bytes, "
+                  << parserStatements << " constant definitions\n\n";
+
+        results.push_back(runBenchmark("BM_ScannerGetNextToken", "tokens", scannerSource.size(), minTime,
+            [&scannerCorpus]()
+            {
+                Scanner scanner(scannerCorpus);
+                long tokens = 0;
+
+                while (scanner.getNextToken().getTokenType() != TokenType::END_OF_FILE)
+                {
+                    tokens++;
+                }
+
+                return tokens;
+            }));
+
+        if (Scanner::getErrorFlag())
+        {
+            std::cerr << "lpc-bench: the generated corpus has token errors" << std::endl;
+            return false;
+        }
+
+        printResult(results.back());
+
+        NullBuffer nullBuffer;
+        std::streambuf* coutBuffer = std::cout.rdbuf(&nullBuffer);
+
+        results.push_back(runBenchmark("BM_ParserParse", "definitions", parserSource.size(), minTime,
+            [&parserCorpus, parserStatements]()
+            {
+                Scanner scanner(parserCorpus);
+                Parser parser(scanner);
+                parser.parse();
+                return parserStatements;
+            }));
+
+        std::cout.rdbuf(coutBuffer);
+
+        if (Scanner::getErrorFlag() || Parser::getErrorFlag())
+        {
+            std::cerr << "lpc-bench: the generated parser corpus has errors" << std::endl;
+            return false;
+        }
+
+        printResult(results.back());
+
+        return true;
+    }
+
+    // the workloads are small, so one repetition runs for minTime and
+    // we use the repetitions to estimate the noise.
+    bool runWorkloadBenchmarks(const std::vector<std::string>& fileNames, double minTime, int repetitions,
+                               const std::string& baselineFileName, std::vector<BenchmarkResult>& results)
+    {
+        std::map<std::string, double> baseline;
+
+        if (!baselineFileName.empty())
+        {
+            baseline = readBaseline(baselineFileName);
+
+            if (baseline.empty())
+            {
+                std::cerr << "lpc-bench: no results found in baseline " << baselineFileName << std::endl;
+                return false;
+            }
+        }
+
+        std::cout << std::left << std::setw(28) << "Benchmark" << std::right
+                  << std::setw(14) << "Mean (us)" << std::setw(14) << "+- CI95 (us)"
+                  << std::setw(14) << "Baseline (us)" << std::setw(10) << "Change" << '\n';
+
+        for (const auto& fileName : fileNames)
+        {
+            std::ifstream input(fileName, std::ios::binary | std::ios::ate);
+
+            if (!input)
+            {
+                std::cerr << "lpc-bench: can not open " << fileName << std::endl;
+                return false;
+            }
+
+            std::size_t bytes = static_cast<std::size_t>(input.tellg());
+            std::string runName = "BM_Scan/" + workloadName(fileName);
+            std::vector<double> samples;
+            BenchmarkResult result;
+
+            for (int i = 0; i < repetitions; ++i)
+            {
+                result = runBenchmark(runName, "tokens", bytes, minTime,
+                    [&fileName]()
+                    {
+                        Scanner scanner(fileName);
+                        long tokens = 0;
+
+                        while (scanner.getNextToken().getTokenType() != TokenType::END_OF_FILE)
+                        {
+                            tokens++;
+                        }
+
+                        return tokens;
+                    });
+
+                results.push_back(result);
+                samples.push_back(result.secondsPerIteration);
+            }
+
+            if (Scanner::getErrorFlag())
+            {
+                std::cerr << "lpc-bench: " << fileName << " has token errors" << std::endl;
+                return false;
+            }
+
+            Statistics statistics = computeStatistics(samples);
+            const char* aggregateNames[] = { "mean", "stddev", "ci95" };
+            double aggregateValues[] = { statistics.mean, statistics.stddev, statistics.ci95 };
+
+            for (int i = 0; i < 3; ++i)
+            {
+                BenchmarkResult aggregate = result;
+                aggregate.name = runName + "_" + aggregateNames[i];
+                aggregate.runName = runName;
+                aggregate.aggregateName = aggregateNames[i];
+                aggregate.iterations = repetitions;
+                aggregate.secondsPerIteration = aggregateValues[i];
+                results.push_back(aggregate);
+            }
+
+            std::cout << std::left << std::setw(28) << runName << std::right << std::fixed << std::setprecision(3)
+                      << std::setw(14) << statistics.mean * 1e6
+                      << std::setw(14) << statistics.ci95 * 1e6;
+
+            auto iter = baseline.find(runName);
+
+            if (iter != baseline.end())
+            {
+                double baselineSeconds = iter->second / 1e9;
+                double change = (statistics.mean - baselineSeconds) / baselineSeconds * 100;
+
+                // only call it a change when the baseline is out of our confidence interval.
+                bool significant = std::fabs(statistics.mean - baselineSeconds) > statistics.ci95;
+
+                std::cout << std::setw(14) << baselineSeconds * 1e6
+                          << std::setw(9) << std::setprecision(1) << std::showpos << change << std::noshowpos << "%"
+                          << (significant ? (change > 0 ? "  slower" : "  faster") : "");
+            }
+
+            std::cout << std::endl;
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CorpusOptions options;
+    double minTime = 0.5;
+    int repetitions = 10;
+    std::string baselineFileName;
+    std::string outputFileName;
+    std::vector<std::string> inputFileNames;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        std::string value;
+
+        if (startsWith(arg, "--seed=", value))
+        {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        }
+        else if (startsWith(arg, "--statements=", value))
+        {
+            options.statementCount = std::strtol(value.c_str(), nullptr, 10);
+        }
+        else if (startsWith(arg, "--expression-density=", value))
+        {
+            options.expressionDensity = std::strtod(value.c_str(), nullptr);
+        }
+        else if (startsWith(arg, "--nesting-depth=", value))
+        {
+            options.nestingDepth = std::atoi(value.c_str());
+        }
+        else if (startsWith(arg, "--comment-ratio=", value))
+        {
+            options.commentRatio = std::strtod(value.c_str(), nullptr);
+        }
+        else if (startsWith(arg, "--identifiers=", value))
+        {
+            options.identifierCount = std::max(1, std::atoi(value.c_str()));
+        }
+        else if (startsWith(arg, "--literal-mix=", value))
+        {
+            char comma;
+            std::istringstream mix(value);
+            mix >> options.integerWeight >> comma >> options.realWeight >> comma
+                >> options.charWeight >> comma >> options.stringWeight;
+        }
+        else if (startsWith(arg, "--min-time=", value))
+        {
+            minTime = std::strtod(value.c_str(), nullptr);
+        }
+        else if (startsWith(arg, "--repetitions=", value))
+        {
+            repetitions = std::max(1, std::atoi(value.c_str()));
+        }
+        else if (startsWith(arg, "--baseline=", value))
+        {
+            baselineFileName = value;
+        }
+        else if (startsWith(arg, "--benchmark_out=", value))
+        {
+            outputFileName = value;
+        }
+        else if (!arg.empty() && arg[0] != '-')
+        {
+            inputFileNames.push_back(arg);
+        }
+        else
+        {
+            printUsage();
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+    bool succeeded = inputFileNames.empty() ?
+                     runCorpusBenchmarks(options, minTime, results) :
+                     runWorkloadBenchmarks(inputFileNames, minTime, repetitions, baselineFileName, results);
+
+    if (!succeeded)
+    {
+        return 1;
+    }
+
+    if (!outputFileName.empty() &&
+        !writeJSON(outputFileName, inputFileNames.empty() ? &options : nullptr, results))
+    {
+        std::cerr << "lpc-bench: can not write " << outputFileName << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
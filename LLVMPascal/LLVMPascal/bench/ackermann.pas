@@ -0,0 +1,20 @@
+program ackermann(output);
+{ Deep recursion: Ackermann function. }
+var
+    m, n : integer;
+
+function ack(m, n : integer) : integer;
+begin
+    if m = 0 then
+        ack := n + 1
+    else if n = 0 then
+        ack := ack(m - 1, 1)
+    else
+        ack := ack(m - 1, ack(m, n - 1))
+end;
+
+begin
+    m := 3;
+    for n := 1 to 9 do
+        writeln('ack(', m, ', ', n, ') = ', ack(m, n))
+end.
@@ -0,0 +1,24 @@
+program dotproduct(output);
+{ Dot product of two real vectors, repeated. The inner loop is the
+  counted array loop the vectorizer should handle. }
+const
+    size = 10000;
+    rounds = 1000;
+type
+    vector = array [1..size] of real;
+var
+    a, b : vector;
+    i, r : integer;
+    sum : real;
+begin
+    for i := 1 to size do
+    begin
+        a[i] := i / size;
+        b[i] := (size - i) / size
+    end;
+    sum := 0.0;
+    for r := 1 to rounds do
+        for i := 1 to size do
+            sum := sum + a[i] * b[i];
+    writeln(sum : 16 : 4)
+end.
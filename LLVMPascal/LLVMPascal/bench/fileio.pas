@@ -0,0 +1,35 @@
+program fileio(output, data);
+{ Write and read back a typed file of records, then a text file. }
+const
+    count = 100000;
+type
+    entry = record
+        key : integer;
+        value : real
+    end;
+var
+    data : file of entry;
+    log : text;
+    e : entry;
+    i : integer;
+    sum : real;
+begin
+    rewrite(data);
+    for i := 1 to count do
+    begin
+        e.key := i;
+        e.value := i * 0.5;
+        write(data, e)
+    end;
+    reset(data);
+    sum := 0.0;
+    while not eof(data) do
+    begin
+        read(data, e);
+        sum := sum + e.value
+    end;
+    rewrite(log);
+    for i := 1 to 1000 do
+        writeln(log, i : 8, sum / i : 16 : 3);
+    writeln(sum : 16 : 1)
+end.
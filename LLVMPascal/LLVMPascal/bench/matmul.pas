@@ -0,0 +1,27 @@
+program matmul(output);
+{ Dense matrix multiply c := a * b with real elements. }
+const
+    size = 200;
+type
+    matrix = array [1..size, 1..size] of real;
+var
+    a, b, c : matrix;
+    i, j, k : integer;
+    sum : real;
+begin
+    for i := 1 to size do
+        for j := 1 to size do
+        begin
+            a[i, j] := (i + j) / size;
+            b[i, j] := (i - j) / size
+        end;
+    for i := 1 to size do
+        for j := 1 to size do
+        begin
+            sum := 0.0;
+            for k := 1 to size do
+                sum := sum + a[i, k] * b[k, j];
+            c[i, j] := sum
+        end;
+    writeln(c[size div 2, size div 2] : 12 : 4)
+end.
@@ -0,0 +1,41 @@
+program nqueens(output);
+{ Count all solutions of the n queens problem by backtracking. }
+const
+    n = 10;
+var
+    column : array [1..n] of boolean;
+    up : array [2..20] of boolean;
+    down : array [-9..9] of boolean;
+    solutions, i : integer;
+
+procedure place(row : integer);
+var
+    col : integer;
+begin
+    for col := 1 to n do
+        if column[col] and up[row + col] and down[row - col] then
+        begin
+            column[col] := false;
+            up[row + col] := false;
+            down[row - col] := false;
+            if row = n then
+                solutions := solutions + 1
+            else
+                place(row + 1);
+            column[col] := true;
+            up[row + col] := true;
+            down[row - col] := true
+        end
+end;
+
+begin
+    for i := 1 to n do
+        column[i] := true;
+    for i := 2 to 2 * n do
+        up[i] := true;
+    for i := 1 - n to n - 1 do
+        down[i] := true;
+    solutions := 0;
+    place(1);
+    writeln(solutions, ' solutions')
+end.
@@ -0,0 +1,51 @@
+program quicksort(output);
+{ Sort pseudo random integers with recursive quicksort. }
+const
+    count = 100000;
+var
+    data : array [1..count] of integer;
+    seed, i : integer;
+
+function random : integer;
+begin
+    seed := (seed * 1103 + 12345) mod 65536;
+    random := seed
+end;
+
+procedure sort(lo, hi : integer);
+var
+    i, j, pivot, tmp : integer;
+begin
+    i := lo;
+    j := hi;
+    pivot := data[(lo + hi) div 2];
+    repeat
+        while data[i] < pivot do
+            i := i + 1;
+        while data[j] > pivot do
+            j := j - 1;
+        if i <= j then
+        begin
+            tmp := data[i];
+            data[i] := data[j];
+            data[j] := tmp;
+            i := i + 1;
+            j := j - 1
+        end
+    until i > j;
+    if lo < j then
+        sort(lo, j);
+    if i < hi then
+        sort(i, hi)
+end;
+
+begin
+    seed := 42;
+    for i := 1 to count do
+        data[i] := random;
+    sort(1, count);
+    for i := 2 to count do
+        if data[i - 1] > data[i] then
+            writeln('not sorted at ', i);
+    writeln(data[1], ' ', data[count])
+end.
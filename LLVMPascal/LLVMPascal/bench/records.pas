@@ -0,0 +1,63 @@
+program records(output);
+{ Record heavy particle simulation with packed flags and linked lists. }
+const
+    particles = 5000;
+    steps = 100;
+type
+    vector = record
+        x, y : real
+    end;
+    link = ^particle;
+    particle = record
+        position, velocity : vector;
+        alive : boolean;
+        kind : (light, heavy);
+        next : link
+    end;
+var
+    world : array [1..particles] of particle;
+    head, p : link;
+    i, step, living : integer;
+begin
+    head := nil;
+    for i := 1 to particles do
+        with world[i] do
+        begin
+            position.x := i;
+            position.y := 0.0;
+            velocity.x := 1.0 / i;
+            velocity.y := 0.5;
+            alive := true;
+            if odd(i) then kind := light else kind := heavy;
+            next := nil
+        end;
+    for step := 1 to steps do
+        for i := 1 to particles do
+            with world[i] do
+                if alive then
+                begin
+                    position.x := position.x + velocity.x;
+                    position.y := position.y + velocity.y;
+                    if kind = heavy then
+                        velocity.y := velocity.y - 0.01;
+                    if position.y < 0.0 then
+                        alive := false
+                end;
+    living := 0;
+    for i := 1 to particles do
+        if world[i].alive then
+        begin
+            new(p);
+            p^ := world[i];
+            p^.next := head;
+            head := p;
+            living := living + 1
+        end;
+    while head <> nil do
+    begin
+        p := head;
+        head := head^.next;
+        dispose(p)
+    end;
+    writeln(living, ' particles alive')
+end.
@@ -0,0 +1,40 @@
+program sets(output);
+{ Set operations on character and small integer sets. }
+type
+    charset = set of char;
+    smallset = set of 0..255;
+var
+    vowels, letters, consonants : charset;
+    evens, odds, multiples, both : smallset;
+    c : char;
+    i, round, total : integer;
+begin
+    vowels := ['a', 'e', 'i', 'o', 'u'];
+    letters := ['a'..'z'];
+    consonants := letters - vowels;
+    total := 0;
+    for round := 1 to 1000 do
+    begin
+        evens := [];
+        odds := [];
+        multiples := [];
+        for i := 0 to 255 do
+        begin
+            if i mod 2 = 0 then
+                evens := evens + [i]
+            else
+                odds := odds + [i];
+            if i mod 3 = 0 then
+                multiples := multiples + [i]
+        end;
+        both := evens * multiples;
+        for i := 0 to 255 do
+            if (i in both) and not (i in odds) then
+                total := total + 1;
+        for c := 'a' to 'z' do
+            if c in consonants then
+                total := total + 1
+    end;
+    if evens <= evens + odds then
+        writeln(total)
+end.
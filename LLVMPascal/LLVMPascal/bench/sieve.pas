@@ -0,0 +1,29 @@
+program sieve(output);
+{ Sieve of Eratosthenes: count the primes below limit, many times. }
+const
+    limit = 8190;
+    rounds = 200;
+var
+    flags : array [0..limit] of boolean;
+    i, k, prime, count, round : integer;
+begin
+    for round := 1 to rounds do
+    begin
+        count := 0;
+        for i := 0 to limit do
+            flags[i] := true;
+        for i := 0 to limit do
+            if flags[i] then
+            begin
+                prime := i + i + 3;
+                k := i + prime;
+                while k <= limit do
+                begin
+                    flags[k] := false;
+                    k := k + prime
+                end;
+                count := count + 1
+            end
+    end;
+    writeln(count, ' primes')
+end.
@@ -0,0 +1,26 @@
+program strings(output);
+{ String building: concatenate, compare and copy short and long strings. }
+const
+    rounds = 20000;
+var
+    line, word, longest : string;
+    i, matches : integer;
+begin
+    longest := '';
+    matches := 0;
+    for i := 1 to rounds do
+    begin
+        if i mod 3 = 0 then
+            word := 'fizz'
+        else if i mod 5 = 0 then
+            word := 'buzz'
+        else
+            word := 'number';
+        line := 'item ' + word + ' in the ''long'' line';
+        if line = 'item fizz in the ''long'' line' then
+            matches := matches + 1;
+        if line > longest then
+            longest := line
+    end;
+    writeln(matches, ' ', longest)
+end.
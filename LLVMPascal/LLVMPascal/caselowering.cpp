@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <set>
+#include <utility>
+#include "caselowering.h"
+
+namespace llvmpascal
+{
+    namespace
+    {
+        // use double, because high - low can overflow long
+        // for labels such as -maxint..maxint.
+        double spanOf(long low, long high)
+        {
+            return static_cast<double>(high) - static_cast<double>(low) + 1;
+        }
+    }
+
+    CaseLowering::CaseLowering(std::vector<CaseLabelRange> labels)
+        : labels_(std::move(labels))
+    {
+        std::stable_sort(labels_.begin(), labels_.end(),
+                         [](const CaseLabelRange& lhs, const CaseLabelRange& rhs)
+                         {
+                             return lhs.low < rhs.low;
+                         });
+
+        buildJumpTables();
+        buildBitTests();
+    }
+
+    bool CaseLowering::findOverlap(std::size_t& first, std::size_t& second) const
+    {
+        // labels are sorted by low, so one label overlaps with the
+        // previous label which reaches farthest.
+        std::size_t farthest = 0;
+
+        for (std::size_t i = 1; i < labels_.size(); ++i)
+        {
+            if (labels_[i].low <= labels_[farthest].high)
+            {
+                first = farthest;
+                second = i;
+                return true;
+            }
+
+            if (labels_[i].high > labels_[farthest].high)
+            {
+                farthest = i;
+            }
+        }
+
+        return false;
+    }
+
+    // Greedy: from every label, take the longest run which is still dense
+    // enough. It is not the optimal partition (LLVM uses dynamic programming),
+    // but it is linear for the common case and good enough for state machines.
+    void CaseLowering::buildJumpTables()
+    {
+        std::size_t first = 0;
+
+        while (first < labels_.size())
+        {
+            std::size_t last = first;
+            double covered = spanOf(labels_[first].low, labels_[first].high);
+
+            for (std::size_t next = first + 1; next < labels_.size(); ++next)
+            {
+                covered += spanOf(labels_[next].low, labels_[next].high);
+                double span = spanOf(labels_[first].low, labels_[next].high);
+
+                if (span > maxJumpTableSpan)
+                {
+                    break;
+                }
+
+                if (covered * 100 >= span * jumpTableDensity)
+                {
+                    last = next;
+                }
+            }
+
+            if (last - first + 1 >= minJumpTableEntries)
+            {
+                clusters_.push_back(CaseCluster{ CaseClusterKind::JUMP_TABLE, labels_[first].low,
+                                                 labels_[last].high, first, last });
+                first = last + 1;
+            }
+            else
+            {
+                clusters_.push_back(CaseCluster{ CaseClusterKind::RANGE, labels_[first].low,
+                                                 labels_[first].high, first, first });
+                first++;
+            }
+        }
+    }
+
+    bool CaseLowering::fitsBitTest(std::size_t first, std::size_t last) const
+    {
+        if (spanOf(labels_[first].low, labels_[last].high) > bitTestWidth)
+        {
+            return false;
+        }
+
+        std::set<std::size_t> targets;
+
+        for (std::size_t i = first; i <= last; ++i)
+        {
+            targets.insert(labels_[i].armIndex);
+        }
+
+        return targets.size() <= maxBitTestTargets;
+    }
+
+    // one bit test is one subtraction, one shift and one mask test per target,
+    // so it is better than one jump table (no memory load) and better than
+    // three or more comparisons.
+    void CaseLowering::buildBitTests()
+    {
+        std::vector<CaseCluster> clusters;
+        std::size_t current = 0;
+
+        while (current < clusters_.size())
+        {
+            CaseCluster cluster = clusters_[current];
+
+            if (cluster.kind == CaseClusterKind::JUMP_TABLE)
+            {
+                if (fitsBitTest(cluster.firstLabel, cluster.lastLabel))
+                {
+                    cluster.kind = CaseClusterKind::BIT_TEST;
+                }
+
+                clusters.push_back(cluster);
+                current++;
+                continue;
+            }
+
+            // merge the following single comparisons as long as they fit.
+            std::size_t last = current;
+
+            while (last + 1 < clusters_.size() &&
+                   clusters_[last + 1].kind == CaseClusterKind::RANGE &&
+                   fitsBitTest(cluster.firstLabel, clusters_[last + 1].lastLabel))
+            {
+                last++;
+            }
+
+            if (clusters_[last].lastLabel - cluster.firstLabel + 1 >= minBitTestLabels)
+            {
+                clusters.push_back(CaseCluster{ CaseClusterKind::BIT_TEST, cluster.low, clusters_[last].high,
+                                                cluster.firstLabel, clusters_[last].lastLabel });
+            }
+            else
+            {
+                clusters.insert(clusters.end(), clusters_.begin() + current, clusters_.begin() + last + 1);
+            }
+
+            current = last + 1;
+        }
+
+        clusters_.swap(clusters);
+    }
+}
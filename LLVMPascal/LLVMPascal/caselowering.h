@@ -0,0 +1,88 @@
+#ifndef CASELOWERING_H_
+#define CASELOWERING_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace llvmpascal
+{
+    // one label of one case-list-element. A single constant
+    // label such as 3 is the range [3, 3], a subrange such as
+    // 'a'..'z' is the range ['a', 'z'].
+    struct CaseLabelRange
+    {
+        long         low;
+        long         high;
+        std::size_t  armIndex;    // which case-list-element it belongs to
+        std::size_t  sourceIndex; // which label it is in the source, labels are sorted later
+    };
+
+    enum class CaseClusterKind
+    {
+        RANGE,         // compare the case index with the label directly
+        JUMP_TABLE,    // dense labels, one indirect branch through a table
+        BIT_TEST       // few targets in one machine word: (1 << (index - low)) & mask
+    };
+
+    // consecutive sorted labels which are lowered together.
+    struct CaseCluster
+    {
+        CaseClusterKind kind;
+        long            low;
+        long            high;
+        std::size_t     firstLabel;   // [firstLabel, lastLabel] of getLabels()
+        std::size_t     lastLabel;
+    };
+
+    // Case statement lowering. It is very like LLVM SwitchLowering:
+    // sorted labels are partitioned into clusters, dense runs become
+    // jump tables, runs with few targets which fit one machine word become
+    // bit tests, others stay single comparisons. Code generation then emits
+    // one balanced binary decision tree over the clusters, so the sparse
+    // labels cost O(log n) comparisons instead of one comparison per label.
+    // Values which are not covered by any label go to the otherwise part.
+    //
+    // see LLVM source: lib/CodeGen/SwitchLoweringUtils.cpp
+    class CaseLowering
+    {
+    public:
+        // the same as LLVM's defaults for jump tables and bit tests.
+        static const std::size_t minJumpTableEntries = 4;
+        static const int         jumpTableDensity = 10;    // percent
+        static const long        maxJumpTableSpan = 4096;  // ours, to limit the table size
+        static const std::size_t maxBitTestTargets = 3;
+        static const long        bitTestWidth = 64;
+        static const std::size_t minBitTestLabels = 3;
+
+        explicit                            CaseLowering(std::vector<CaseLabelRange> labels);
+
+        // sorted by low.
+        const std::vector<CaseLabelRange>&  getLabels() const;
+        const std::vector<CaseCluster>&     getClusters() const;
+
+        // one label value appears more than once. Pascal standard 6.8.3.5
+        // says it is an error. The two labels are returned by index.
+        bool                                findOverlap(std::size_t& first, std::size_t& second) const;
+
+    private:
+        void                                buildJumpTables();
+        void                                buildBitTests();
+        bool                                fitsBitTest(std::size_t first, std::size_t last) const;
+
+    private:
+        std::vector<CaseLabelRange>         labels_;
+        std::vector<CaseCluster>            clusters_;
+    };
+
+    inline const std::vector<CaseLabelRange>& CaseLowering::getLabels() const
+    {
+        return labels_;
+    }
+
+    inline const std::vector<CaseCluster>& CaseLowering::getClusters() const
+    {
+        return clusters_;
+    }
+}
+
+#endif // caselowering.h
@@ -11,6 +11,7 @@
 *********************************/
 
 #include "constant.h"
+#include "memstats.h"
 
 namespace llvmpascal
 {
@@ -19,6 +20,18 @@ namespace llvmpascal
         : constantKind_(kind), tokenLocation_(loc)
     {}
 
+    void* Constant::operator new(std::size_t size)
+    {
+        MemoryStats::allocate(MemoryCategory::CONSTANT, size);
+        return ::operator new(size);
+    }
+
+    void Constant::operator delete(void* ptr, std::size_t size)
+    {
+        MemoryStats::deallocate(MemoryCategory::CONSTANT, size);
+        ::operator delete(ptr);
+    }
+
     IntegerConstant::IntegerConstant(long l, const TokenLocation& loc)
         : Constant(ConstantKind::INTEGER_CONSTANT, loc), value_(l)
     {}
@@ -13,6 +13,7 @@
 #ifndef CONSTANT_H_
 #define CONSTANT_H_
 
+#include <cstddef>
 // Need token for "location". 
 #include "token.h"
 namespace llvmpascal
@@ -36,6 +37,10 @@ namespace llvmpascal
         virtual Token      makeToken() const = 0;
         virtual void       dump() const = 0;
 
+        // count constant memory for -fmem-report.
+        static void*       operator new(std::size_t size);
+        static void        operator delete(void* ptr, std::size_t size);
+
     protected:
         const ConstantKind constantKind_;
         TokenLocation      tokenLocation_;
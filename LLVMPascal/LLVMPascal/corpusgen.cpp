@@ -0,0 +1,345 @@
+#include "corpusgen.h"
+
+namespace llvmpascal
+{
+    namespace
+    {
+        const char* const addingOperators[] = { " + ", " - ", " or " };
+        const char* const multiplyingOperators[] = { " * ", " / ", " div ", " mod ", " and " };
+        const char* const relationalOperators[] = { " = ", " <> ", " < ", " <= ", " > ", " >= " };
+        const char* const words[] = { "hello", "world", "pascal", "compiler", "token", "scanner",
+                                      "parser", "benchmark", "it''s", "LLVM" };
+    }
+
+    CorpusGenerator::CorpusGenerator(const CorpusOptions& options)
+        : options_(options), state_(options.seed ? options.seed : 1), statements_(0)
+    {}
+
+    std::uint32_t CorpusGenerator::next()
+    {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 17;
+        state_ ^= state_ << 5;
+        return state_;
+    }
+
+    int CorpusGenerator::range(int n)
+    {
+        return static_cast<int>(next() % static_cast<std::uint32_t>(n));
+    }
+
+    bool CorpusGenerator::chance(double probability)
+    {
+        return (next() % 10000) < static_cast<std::uint32_t>(probability * 10000);
+    }
+
+    std::string CorpusGenerator::generate()
+    {
+        state_ = options_.seed ? options_.seed : 1;
+        output_.clear();
+        statements_ = 0;
+        generateProgram();
+        return output_;
+    }
+
+    std::string CorpusGenerator::identifier()
+    {
+        return "v" + std::to_string(range(options_.identifierCount));
+    }
+
+    void CorpusGenerator::generateIndent(int indent)
+    {
+        output_.append(indent * 4, ' ');
+    }
+
+    // Note: the comment always ends with new line, because the scanner
+    // only skips one comment of each kind between two white spaces.
+    void CorpusGenerator::generateComment(int indent)
+    {
+        generateIndent(indent);
+
+        if (range(2) == 0)
+        {
+            output_ += "{ ";
+            output_ += words[range(10)];
+            output_ += " comment }\n";
+        }
+        else
+        {
+            output_ += "(* ";
+            output_ += words[range(10)];
+            output_ += " comment *)\n";
+        }
+    }
+
+    void CorpusGenerator::generateLiteral(bool allowSign)
+    {
+        int total = options_.integerWeight + options_.realWeight +
+                    options_.charWeight + options_.stringWeight;
+        int pick = range(total > 0 ? total : 1);
+
+        if (pick < options_.integerWeight)
+        {
+            if (allowSign && range(4) == 0)
+            {
+                output_ += '-';
+            }
+
+            if (range(8) == 0)
+            {
+                output_ += "$" + std::to_string(range(10)) + "F";
+            }
+            else
+            {
+                output_ += std::to_string(range(100000));
+            }
+
+            return;
+        }
+
+        pick -= options_.integerWeight;
+
+        if (pick < options_.realWeight)
+        {
+            if (allowSign && range(4) == 0)
+            {
+                output_ += '-';
+            }
+
+            output_ += std::to_string(range(1000)) + "." + std::to_string(range(1000));
+
+            if (range(3) == 0)
+            {
+                output_ += "e+" + std::to_string(range(20));
+            }
+
+            return;
+        }
+
+        pick -= options_.realWeight;
+
+        if (pick < options_.charWeight)
+        {
+            output_ += '\'';
+            output_ += static_cast<char>('a' + range(26));
+            output_ += '\'';
+            return;
+        }
+
+        output_ += '\'';
+        output_ += words[range(10)];
+        output_ += ' ';
+        output_ += words[range(10)];
+        output_ += '\'';
+    }
+
+    void CorpusGenerator::generatePrimary(int depth)
+    {
+        switch (range(6))
+        {
+            case 0:
+            case 1:
+                output_ += identifier();
+                break;
+
+            case 2:
+                if (depth < options_.nestingDepth)
+                {
+                    output_ += '(';
+                    generateExpression(depth + 1);
+                    output_ += ')';
+                    break;
+                }
+                output_ += identifier();
+                break;
+
+            case 3:
+                if (depth < options_.nestingDepth)
+                {
+                    output_ += "f" + std::to_string(range(8)) + "(";
+                    generateExpression(depth + 1);
+                    output_ += ')';
+                    break;
+                }
+                output_ += identifier();
+                break;
+
+            default:
+                generateLiteral(false);
+                break;
+        }
+    }
+
+    void CorpusGenerator::generateExpression(int depth)
+    {
+        if (range(8) == 0)
+        {
+            output_ += "not ";
+        }
+
+        generatePrimary(depth);
+
+        // at most 4 operators in one expression. Otherwise nested parentheses
+        // and function arguments make the expression grow exponentially.
+        for (int operators = 0; operators < 4 && chance(options_.expressionDensity); ++operators)
+        {
+            output_ += range(2) == 0 ? addingOperators[range(3)] : multiplyingOperators[range(5)];
+            generatePrimary(depth);
+        }
+    }
+
+    void CorpusGenerator::generateStatement(int depth, int indent)
+    {
+        if (chance(options_.commentRatio))
+        {
+            generateComment(indent);
+        }
+
+        generateIndent(indent);
+        statements_++;
+
+        int kind = depth < options_.nestingDepth ? range(10) : 0;
+
+        switch (kind)
+        {
+            case 5:
+                output_ += "if ";
+                generateExpression(0);
+                output_ += relationalOperators[range(6)];
+                generateExpression(0);
+                output_ += " then\n";
+                generateStatement(depth + 1, indent + 1);
+                output_ += '\n';
+                generateIndent(indent);
+                output_ += "else\n";
+                generateStatement(depth + 1, indent + 1);
+                break;
+
+            case 6:
+                output_ += "while ";
+                generateExpression(0);
+                output_ += relationalOperators[range(6)];
+                generateExpression(0);
+                output_ += " do\n";
+                generateIndent(indent);
+                output_ += "begin\n";
+                generateStatements(1 + range(3), depth + 1, indent + 1);
+                generateIndent(indent);
+                output_ += "end";
+                break;
+
+            case 7:
+                output_ += "for " + identifier() + " := ";
+                generateExpression(0);
+                output_ += range(2) == 0 ? " to " : " downto ";
+                generateExpression(0);
+                output_ += " do\n";
+                generateStatement(depth + 1, indent + 1);
+                break;
+
+            case 8:
+                output_ += "repeat\n";
+                generateStatements(1 + range(3), depth + 1, indent + 1);
+                generateIndent(indent);
+                output_ += "until ";
+                generateExpression(0);
+                output_ += relationalOperators[range(6)];
+                generateExpression(0);
+                break;
+
+            case 9:
+                output_ += range(2) == 0 ? "writeln(" : "write(";
+                generateExpression(0);
+                output_ += ", ";
+                generateLiteral(false);
+                output_ += ')';
+                break;
+
+            default:
+                output_ += identifier() + " := ";
+                generateExpression(0);
+                break;
+        }
+    }
+
+    void CorpusGenerator::generateStatements(long count, int depth, int indent)
+    {
+        for (long i = 0; i < count; ++i)
+        {
+            generateStatement(depth, indent);
+            output_ += ";\n";
+        }
+    }
+
+    void CorpusGenerator::generateConstantSection(long count)
+    {
+        output_ += "const\n";
+
+        for (long i = 0; i < count; ++i)
+        {
+            if (chance(options_.commentRatio))
+            {
+                generateComment(1);
+            }
+
+            generateIndent(1);
+            output_ += "c" + std::to_string(i) + " = ";
+            generateLiteral(true);
+            output_ += ";\n";
+            statements_++;
+        }
+    }
+
+    void CorpusGenerator::generateVariableSection()
+    {
+        output_ += "var\n";
+
+        for (int i = 0; i < options_.identifierCount; ++i)
+        {
+            generateIndent(1);
+            output_ += "v" + std::to_string(i);
+            output_ += range(2) == 0 ? ": integer;\n" : ": real;\n";
+        }
+    }
+
+    void CorpusGenerator::generateProcedures()
+    {
+        // every procedure has about 50 statements.
+        long procedureCount = options_.statementCount / 100;
+
+        for (long i = 0; i < procedureCount; ++i)
+        {
+            output_ += "\nprocedure p" + std::to_string(i) + "(a: integer; var b: real);\n";
+            output_ += "begin\n";
+            generateStatements(50, 0, 1);
+            output_ += "end;\n";
+        }
+    }
+
+    void CorpusGenerator::generateProgram()
+    {
+        output_ += "program bench(input, output);\n";
+
+        if (options_.parserSubset)
+        {
+            generateConstantSection(options_.statementCount);
+            output_ += "begin\nend.\n";
+            return;
+        }
+
+        generateConstantSection(options_.identifierCount / 4);
+        generateVariableSection();
+        generateProcedures();
+
+        output_ += "\nbegin\n";
+
+        // the procedures use the half of statements.
+        while (statements_ < options_.statementCount)
+        {
+            generateStatement(0, 1);
+            output_ += ";\n";
+        }
+
+        output_ += "end.\n";
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef CORPUSGEN_H_
+#define CORPUSGEN_H_
+
+#include <cstdint>
+#include <string>
+
+namespace llvmpascal
+{
+    // Knobs of the synthetic Pascal program generator.
+    // The same options and seed always generate the same program on every
+    // platform, so the benchmark results can be compared between runs.
+    struct CorpusOptions
+    {
+        std::uint32_t seed              = 20161;
+        long          statementCount    = 20000;  // how many statements (or constant definitions)
+        double        expressionDensity = 0.5;    // probability to continue an expression with one more operator (max 4)
+        int           nestingDepth      = 4;      // max depth of nested statements / parenthesized expressions
+        double        commentRatio      = 0.1;    // probability of one comment before a statement
+        int           identifierCount   = 200;    // distinct variable names
+
+        // literal mix, relative weights.
+        int           integerWeight     = 6;
+        int           realWeight        = 2;
+        int           charWeight        = 1;
+        int           stringWeight      = 1;
+
+        // only generate what Parser::parse can handle now, i.e. program heading,
+        // constant definitions and an empty program block. Statements and
+        // expressions are not supported by the parser yet.
+        bool          parserSubset      = false;
+    };
+
+    class CorpusGenerator
+    {
+    public:
+        explicit      CorpusGenerator(const CorpusOptions& options);
+        std::string   generate();
+
+        // how many statements (constant definitions in the parser subset)
+        // the last generate call produced.
+        long          getStatementCount() const;
+
+    private:
+        // xorshift32. We don't use <random> distributions because their
+        // results are not the same between standard library implementations.
+        std::uint32_t next();
+        int           range(int n);
+        bool          chance(double probability);
+
+        void          generateProgram();
+        void          generateConstantSection(long count);
+        void          generateVariableSection();
+        void          generateProcedures();
+        void          generateStatements(long count, int depth, int indent);
+        void          generateStatement(int depth, int indent);
+        void          generateExpression(int depth);
+        void          generatePrimary(int depth);
+        void          generateLiteral(bool allowSign);
+        void          generateComment(int indent);
+        void          generateIndent(int indent);
+        std::string   identifier();
+
+    private:
+        CorpusOptions options_;
+        std::uint32_t state_;
+        std::string   output_;
+        long          statements_;
+    };
+
+    inline long CorpusGenerator::getStatementCount() const
+    {
+        return statements_;
+    }
+}
+
+#endif // corpusgen.h
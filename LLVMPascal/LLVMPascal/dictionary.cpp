@@ -10,6 +10,7 @@
 * License: BSD
 *********************************/
 #include "dictionary.h"
+#include "memstats.h"
 
 namespace llvmpascal
 {
@@ -99,6 +100,10 @@ namespace llvmpascal
         addToken("write",        std::make_tuple(TokenValue::WRITE,            TokenType::KEYWORDS,  -1));
         addToken("writeln",      std::make_tuple(TokenValue::WRITELN,          TokenType::KEYWORDS,  -1));
         addToken("in",           std::make_tuple(TokenValue::IN,               TokenType::KEYWORDS,  2));
+        addToken("unit",         std::make_tuple(TokenValue::UNIT,             TokenType::KEYWORDS,  -1));
+        addToken("interface",    std::make_tuple(TokenValue::INTERFACE,        TokenType::KEYWORDS,  -1));
+        addToken("implementation", std::make_tuple(TokenValue::IMPLEMENTATION, TokenType::KEYWORDS,  -1));
+        addToken("uses",         std::make_tuple(TokenValue::USES,             TokenType::KEYWORDS,  -1));
         addToken("or",           std::make_tuple(TokenValue::OR,               TokenType::KEYWORDS,  10));
         addToken("xor",          std::make_tuple(TokenValue::XOR,              TokenType::KEYWORDS,  10));
         addToken("div",          std::make_tuple(TokenValue::DIV,              TokenType::KEYWORDS,  20));
@@ -111,7 +116,27 @@ namespace llvmpascal
     void Dictionary::addToken(std::string name,
                               std::tuple<TokenValue, TokenType, int> tokenMeta)
     {
-        dictionary_.insert(std::pair<decltype(name), decltype(tokenMeta)>(name, tokenMeta));
+        auto result = dictionary_.insert(std::pair<decltype(name), decltype(tokenMeta)>(name, tokenMeta));
+
+        if (result.second)
+        {
+            MemoryStats::allocate(MemoryCategory::DICTIONARY, nodeBytes(result.first->first));
+        }
+    }
+
+    Dictionary::~Dictionary()
+    {
+        for (const auto& entry : dictionary_)
+        {
+            MemoryStats::deallocate(MemoryCategory::DICTIONARY, nodeBytes(entry.first));
+        }
+    }
+
+    std::size_t Dictionary::nodeBytes(const std::string& name)
+    {
+        // one std::map node is the value pair plus three links and the color.
+        return sizeof(decltype(dictionary_)::value_type) + 4 * sizeof(void*) +
+               MemoryStats::stringHeapBytes(name);
     }
 
     // if we can find it in the dictionary, we change the token type
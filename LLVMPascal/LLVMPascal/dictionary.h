@@ -24,10 +24,12 @@ namespace llvmpascal
     {
       public:
         Dictionary();
+        ~Dictionary();
         std::tuple<TokenType, TokenValue, int> lookup(const std::string& name) const;
         bool haveToken(const std::string& name) const;
       private:
         void addToken(std::string name, std::tuple<TokenValue, TokenType, int> tokenMeta);
+        static std::size_t nodeBytes(const std::string& name);
 
       private:
         // four token property: token name, token value, token type, precedence.
@@ -11,6 +11,7 @@
 *********************************/
 
 
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -18,23 +19,161 @@
 #include "dictionary.h"
 #include "scanner.h"
 #include "parser.h"
+#include "memstats.h"
+#include "rangecheck.h"
+#include "timetrace.h"
 using namespace llvmpascal;
 
-int main()
+namespace
 {
-    Scanner scanner("program_test.pas");
-    //Scanner scanner("scanner_test.pas");
+    void printUsage()
+    {
+        std::cerr << "Usage: lpc [options] [file]\n"
+                  << "Options:\n"
+                  << "  -ftime-report                   Print compile phase time report\n"
+                  << "  -ftime-trace[=<file>]           Write Chrome trace-event JSON (default: <file>.json)\n"
+                  << "  -ftime-trace-granularity=<us>   Minimum event duration kept in the trace (default: 500)\n"
+                  << "  -fmem-report                    Print compiler memory report\n"
+                  << "  -fmem-report-json=<file>        Write compiler memory report as JSON\n"
+                  << "  -frange-check-report            Print how many range checks are eliminated\n";
+    }
 
-    //scanner.getNextToken();
+    // hello.pas -> hello.json
+    std::string defaultTraceFileName(const std::string& srcFileName)
+    {
+        auto dot = srcFileName.find_last_of('.');
+        auto slash = srcFileName.find_last_of("/\\");
 
-    //while (scanner.getToken().getTokenType() != TokenType::END_OF_FILE)
-    //{
-    //    scanner.getToken().dump();
-    //    scanner.getNextToken();
-    //}
-    Parser parser(scanner);
-    parser.parse();
-    
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        {
+            return srcFileName + ".json";
+        }
+
+        return srcFileName.substr(0, dot) + ".json";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string srcFileName = "program_test.pas";
+    //std::string srcFileName = "scanner_test.pas";
+    bool timeReport = false;
+    bool timeTrace = false;
+    std::string timeTraceFileName;
+    long timeTraceGranularity = 500;
+    bool memReport = false;
+    std::string memReportFileName;
+    bool rangeCheckReport = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "-ftime-report")
+        {
+            timeReport = true;
+        }
+        else if (arg == "-ftime-trace")
+        {
+            timeTrace = true;
+        }
+        else if (arg.compare(0, 13, "-ftime-trace=") == 0)
+        {
+            timeTrace = true;
+            timeTraceFileName = arg.substr(13);
+        }
+        else if (arg.compare(0, 25, "-ftime-trace-granularity=") == 0)
+        {
+            timeTraceGranularity = std::strtol(arg.c_str() + 25, nullptr, 10);
+        }
+        else if (arg == "-fmem-report")
+        {
+            memReport = true;
+        }
+        else if (arg.compare(0, 18, "-fmem-report-json=") == 0)
+        {
+            memReportFileName = arg.substr(18);
+        }
+        else if (arg == "-frange-check-report")
+        {
+            rangeCheckReport = true;
+        }
+        else if (arg == "-h" || arg == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            std::cerr << "lpc: unknown option '" << arg << "'" << std::endl;
+            printUsage();
+            return 1;
+        }
+        else
+        {
+            srcFileName = arg;
+        }
+    }
+
+    if (timeReport || timeTrace)
+    {
+        // the report wants every scope, so granularity only
+        // filters the events written to the trace file.
+        TimeTracer::enable(timeTrace ? timeTraceGranularity : 0);
+    }
+
+    {
+        TimeTraceScope timeScope("Total", srcFileName);
+
+        Scanner scanner(srcFileName);
+        MemoryStats::recordPhase("initialize");
+
+        //scanner.getNextToken();
+
+        //while (scanner.getToken().getTokenType() != TokenType::END_OF_FILE)
+        //{
+        //    scanner.getToken().dump();
+        //    scanner.getNextToken();
+        //}
+        Parser parser(scanner);
+        parser.parse();
+        MemoryStats::recordPhase("parse");
+    }
+
+    if (timeReport)
+    {
+        TimeTracer::printReport(std::cerr);
+    }
+
+    if (memReport)
+    {
+        MemoryStats::printReport(std::cerr);
+    }
+
+    if (rangeCheckReport)
+    {
+        RangeCheck::printReport(std::cerr);
+    }
+
+    if (!memReportFileName.empty() && !MemoryStats::writeJSON(memReportFileName))
+    {
+        std::cerr << "lpc: can not write memory report file " << memReportFileName << std::endl;
+        return 1;
+    }
+
+    if (timeTrace)
+    {
+        if (timeTraceFileName.empty())
+        {
+            timeTraceFileName = defaultTraceFileName(srcFileName);
+        }
+
+        if (!TimeTracer::writeTrace(timeTraceFileName))
+        {
+            std::cerr << "lpc: can not write time trace file " << timeTraceFileName << std::endl;
+            return 1;
+        }
+    }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,160 @@
+#include <fstream>
+#include <iomanip>
+#include "memstats.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+namespace llvmpascal
+{
+    MemoryStats::Counter MemoryStats::counters_[static_cast<int>(MemoryCategory::CATEGORY_COUNT)];
+    std::vector<MemoryStats::Phase> MemoryStats::phases_;
+
+    namespace
+    {
+        const char* categoryName(int category)
+        {
+            switch (static_cast<MemoryCategory>(category))
+            {
+                case MemoryCategory::TOKEN:
+                    return "token";
+
+                case MemoryCategory::DICTIONARY:
+                    return "dictionary";
+
+                case MemoryCategory::AST:
+                    return "ast";
+
+                case MemoryCategory::CONSTANT:
+                    return "constant";
+
+                default:
+                    return "unknown";
+            }
+        }
+
+        // peak resident set size of the whole process in KB.
+        long peakResidentKB()
+        {
+#ifdef _WIN32
+            PROCESS_MEMORY_COUNTERS pmc;
+
+            if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+            {
+                return static_cast<long>(pmc.PeakWorkingSetSize / 1024);
+            }
+
+            return 0;
+#else
+            struct rusage usage;
+
+            if (getrusage(RUSAGE_SELF, &usage) != 0)
+            {
+                return 0;
+            }
+
+#ifdef __APPLE__
+            // macOS reports it in bytes, Linux in KB.
+            return static_cast<long>(usage.ru_maxrss / 1024);
+#else
+            return static_cast<long>(usage.ru_maxrss);
+#endif
+#endif
+        }
+    }
+
+    std::size_t MemoryStats::liveBytes()
+    {
+        std::size_t bytes = 0;
+
+        for (const auto& counter : counters_)
+        {
+            bytes += counter.liveBytes;
+        }
+
+        return bytes;
+    }
+
+    void MemoryStats::recordPhase(const std::string& phaseName)
+    {
+        phases_.push_back(Phase{ phaseName, liveBytes(), peakResidentKB() });
+    }
+
+    void MemoryStats::printReport(std::ostream& out)
+    {
+        const int categoryCount = static_cast<int>(MemoryCategory::CATEGORY_COUNT);
+
+        out << "===-------------------------------------------------------------------------===\n"
+            << "                          lpc memory report\n"
+            << "===-------------------------------------------------------------------------===\n"
+            << "  Category          Count     Total (B)      Live (B)      Peak (B)\n";
+
+        for (int i = 0; i < categoryCount; ++i)
+        {
+            const Counter& counter = counters_[i];
+            out << "  " << std::left << std::setw(12) << categoryName(i) << std::right
+                << std::setw(11) << counter.count
+                << std::setw(14) << counter.totalBytes
+                << std::setw(14) << counter.liveBytes
+                << std::setw(14) << counter.peakBytes << '\n';
+        }
+
+        out << "\n  Phase                     Live (B)   Peak RSS (KB)\n";
+
+        for (const auto& phase : phases_)
+        {
+            out << "  " << std::left << std::setw(20) << phase.name << std::right
+                << std::setw(14) << phase.liveBytes
+                << std::setw(16) << phase.peakResidentKB << '\n';
+        }
+
+        out.flush();
+    }
+
+    bool MemoryStats::writeJSON(const std::string& fileName)
+    {
+        const int categoryCount = static_cast<int>(MemoryCategory::CATEGORY_COUNT);
+        std::ofstream output(fileName);
+
+        if (!output)
+        {
+            return false;
+        }
+
+        output << "{\n  \"categories\": {";
+
+        for (int i = 0; i < categoryCount; ++i)
+        {
+            const Counter& counter = counters_[i];
+            output << (i == 0 ? "\n" : ",\n")
+                   << "    \"" << categoryName(i) << "\": {"
+                   << "\"count\": " << counter.count
+                   << ", \"totalBytes\": " << counter.totalBytes
+                   << ", \"liveBytes\": " << counter.liveBytes
+                   << ", \"peakBytes\": " << counter.peakBytes << "}";
+        }
+
+        output << "\n  },\n  \"phases\": [";
+
+        bool first = true;
+
+        for (const auto& phase : phases_)
+        {
+            // phase names are our own identifiers, no escape is needed.
+            output << (first ? "\n" : ",\n")
+                   << "    {\"name\": \"" << phase.name << "\""
+                   << ", \"liveBytes\": " << phase.liveBytes
+                   << ", \"peakResidentKB\": " << phase.peakResidentKB << "}";
+            first = false;
+        }
+
+        output << "\n  ]\n}\n";
+
+        return static_cast<bool>(output);
+    }
+}
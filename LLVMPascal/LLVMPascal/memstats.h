@@ -0,0 +1,117 @@
+#ifndef MEMSTATS_H_
+#define MEMSTATS_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace llvmpascal
+{
+    // which part of the compiler the memory belongs to.
+    // symbol table and LLVM module will be added when we have them.
+    enum class MemoryCategory
+    {
+        TOKEN,
+        DICTIONARY,
+        AST,
+        CONSTANT,
+        CATEGORY_COUNT
+    };
+
+    // Memory accounting for -fmem-report, very like GCC's option of the same name.
+    // The counters are plain integer additions, so they are always on and
+    // the option just decides whether we print them.
+    //
+    // Tokens are counted by their constructors, assignments and destructor
+    // (together with their string buffers), the dictionary by its constructor
+    // and destructor. AST nodes and constants are counted exactly by their
+    // class operator new / delete.
+    class MemoryStats
+    {
+    public:
+        static void        allocate(MemoryCategory category, std::size_t bytes);
+        static void        deallocate(MemoryCategory category, std::size_t bytes);
+
+        // an object changed its size in place, for example a token which is assigned.
+        // this is not a new allocation, so the count is not changed.
+        static void        resize(MemoryCategory category, std::size_t oldBytes,
+                                  std::size_t newBytes);
+
+        // remember the process peak memory when one compile phase is finished.
+        static void        recordPhase(const std::string& phaseName);
+
+        static void        printReport(std::ostream& out);
+        static bool        writeJSON(const std::string& fileName);
+
+        // heap bytes used by one std::string. zero if it is still in the
+        // small string buffer.
+        static std::size_t stringHeapBytes(const std::string& str);
+
+    private:
+        struct Counter
+        {
+            long           count;
+            std::size_t    totalBytes;
+            std::size_t    liveBytes;
+            std::size_t    peakBytes;
+        };
+
+        struct Phase
+        {
+            std::string    name;
+            std::size_t    liveBytes;
+            long           peakResidentKB;
+        };
+
+        static std::size_t liveBytes();
+
+        static Counter             counters_[static_cast<int>(MemoryCategory::CATEGORY_COUNT)];
+        static std::vector<Phase>  phases_;
+    };
+
+    inline void MemoryStats::allocate(MemoryCategory category, std::size_t bytes)
+    {
+        Counter& counter = counters_[static_cast<int>(category)];
+        counter.count++;
+        counter.totalBytes += bytes;
+        counter.liveBytes += bytes;
+
+        if (counter.liveBytes > counter.peakBytes)
+        {
+            counter.peakBytes = counter.liveBytes;
+        }
+    }
+
+    inline void MemoryStats::deallocate(MemoryCategory category, std::size_t bytes)
+    {
+        counters_[static_cast<int>(category)].liveBytes -= bytes;
+    }
+
+    inline void MemoryStats::resize(MemoryCategory category, std::size_t oldBytes,
+                                    std::size_t newBytes)
+    {
+        if (newBytes <= oldBytes)
+        {
+            counters_[static_cast<int>(category)].liveBytes -= oldBytes - newBytes;
+            return;
+        }
+
+        Counter& counter = counters_[static_cast<int>(category)];
+        counter.totalBytes += newBytes - oldBytes;
+        counter.liveBytes += newBytes - oldBytes;
+
+        if (counter.liveBytes > counter.peakBytes)
+        {
+            counter.peakBytes = counter.liveBytes;
+        }
+    }
+
+    inline std::size_t MemoryStats::stringHeapBytes(const std::string& str)
+    {
+        static const std::size_t smallCapacity = std::string().capacity();
+        return str.capacity() > smallCapacity ? str.capacity() + 1 : 0;
+    }
+}
+
+#endif // memstats.h
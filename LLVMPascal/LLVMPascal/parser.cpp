@@ -9,9 +9,11 @@
 *
 * License: BSD
 *********************************/
+#include <algorithm>
 #include "parser.h"
 #include "error.h"
 #include "constant.h"
+#include "timetrace.h"
 
 namespace llvmpascal
 {
@@ -81,11 +83,22 @@ namespace llvmpascal
 
     VecExprASTPtr& Parser::parse()
     {
-        if (!parseProgramStatement())
+        TimeTraceScope timeScope("Parse");
+
+        if (validateToken(TokenValue::UNIT, false))
+        {
+            return parseUnit();
+        }
+
+        ExprASTPtr program = parseProgramStatement();
+
+        if (program == nullptr)
         {
             return ast_;
         }
 
+        ast_.push_back(std::move(program));
+
         if (scanner_.getToken().getTokenType() == TokenType::END_OF_FILE)
         {
             errorReport("Unexpected end of file.");
@@ -186,12 +199,18 @@ namespace llvmpascal
 
     */
 
+    // The uses clause after the heading is a Turbo Pascal / Free Pascal
+    // extension, see parseUnit.
+
     // Example:
     // PROGRAM helloworld;
     // PROGRAM helloworld(input, output);
+    // PROGRAM helloworld; USES strings;
 
     ExprASTPtr Parser::parseProgramStatement()
     {
+        TimeTraceScope timeScope("ParseProgramStatement");
+
         TokenLocation loc = scanner_.getToken().getTokenLocation();
 
         if (!expectToken(TokenValue::PROGRAM, "program", true))
@@ -239,11 +258,180 @@ namespace llvmpascal
             return nullptr;
         }
 
-        return std::make_unique<ProgramAST>(loc, programName);
+        // uses clause, the same as the one in units.
+        std::vector<std::string> usedUnits;
+
+        if (validateToken(TokenValue::USES, false) && !parseUsesClause(usedUnits))
+        {
+            return nullptr;
+        }
+
+        return std::make_unique<ProgramAST>(loc, programName, std::move(usedUnits));
+    }
+
+    // Units, Turbo Pascal / Free Pascal extension. They are not in pascal standard.
+    //
+    // unit = 'unit' identifier ';'
+    //        'interface' [ uses-clause ] interface-part
+    //        'implementation' [ uses-clause ] implementation-part
+    //        ( 'end' | block-statement ) '.' .
+    // uses-clause = 'uses' identifier { ',' identifier } ';' .
+    //
+    // interface-part has constant, type and variable definitions and
+    // procedure / function headings, implementation-part has their bodies.
+    // the block statement at the end is the unit initialization.
+    //
+    // [Example]
+    //     unit geometry;
+    //     interface
+    //     uses math;
+    //     const pi = 3.14159;
+    //     implementation
+    //     end.
+    // [/Example]
+    //
+    // The uses clauses are kept in UnitAST, they are the units which must be
+    // compiled before this one.
+    VecExprASTPtr& Parser::parseUnit()
+    {
+        TokenLocation loc = scanner_.getToken().getTokenLocation();
+
+        if (!expectToken(TokenValue::UNIT, "unit", true) ||
+            !expectToken(TokenType::IDENTIFIER, "identifier", false))
+        {
+            return ast_;
+        }
+
+        std::string unitName = scanner_.getToken().getIdentifierName();
+        scanner_.getNextToken();
+        std::vector<std::string> interfaceUses;
+        std::vector<std::string> implementationUses;
+
+        if (!expectToken(TokenValue::SEMICOLON, ";", true) ||
+            !expectToken(TokenValue::INTERFACE, "interface", true) ||
+            (validateToken(TokenValue::USES, false) && !parseUsesClause(interfaceUses)) ||
+            !parseUnitDeclarations(true) ||
+            !expectToken(TokenValue::IMPLEMENTATION, "implementation", true) ||
+            (validateToken(TokenValue::USES, false) && !parseUsesClause(implementationUses)) ||
+            !parseUnitDeclarations(false))
+        {
+            ast_.clear();
+            return ast_;
+        }
+
+        ast_.push_back(std::make_unique<UnitAST>(loc, unitName,
+            std::move(interfaceUses), std::move(implementationUses)));
+
+        if (validateToken(TokenValue::BEGIN, false))
+        {
+            BlockASTPtr initialization = parseBlockStatement();
+
+            if (initialization == nullptr)
+            {
+                ast_.clear();
+                return ast_;
+            }
+
+            ast_.push_back(std::move(initialization));
+        }
+        else if (!expectToken(TokenValue::END, "end", true))
+        {
+            ast_.clear();
+            return ast_;
+        }
+
+        if (!expectToken(TokenValue::PERIOD, ".", true))
+        {
+            ast_.clear();
+        }
+
+        return ast_;
+    }
+
+    bool Parser::parseUsesClause(std::vector<std::string>& unitNames)
+    {
+        if (!expectToken(TokenValue::USES, "uses", true))
+        {
+            return false;
+        }
+
+        do
+        {
+            if (!expectToken(TokenType::IDENTIFIER, "identifier", false))
+            {
+                return false;
+            }
+
+            unitNames.push_back(scanner_.getToken().getIdentifierName());
+            scanner_.getNextToken();
+        } while (validateToken(TokenValue::COMMA, true));
+
+        return expectToken(TokenValue::SEMICOLON, ";", true);
+    }
+
+    // stop at 'implementation' (interface part) or 'begin' / 'end' (implementation part).
+    bool Parser::parseUnitDeclarations(bool isInterface)
+    {
+        for (;;)
+        {
+            switch (scanner_.getToken().getTokenValue())
+            {
+                case TokenValue::CONST:
+                    parseConstantDefinition();
+                    break;
+
+                // TODO: parseTypeDefinition, parseVariableDeclaration, parseFunctionDeclaration
+                // (interface part) and parseFunctionDefinition (implementation part) are not
+                // implemented yet, so report it instead of asserting in them.
+                case TokenValue::TYPE:
+                case TokenValue::VAR:
+                case TokenValue::FUNCTION:
+                case TokenValue::PROCEDURE:
+                    errorReport("Sorry, " + scanner_.getToken().getTokenName() +
+                                " declaration in unit is not supported now.");
+                    return false;
+
+                case TokenValue::SEMICOLON:
+                    scanner_.getNextToken();
+                    break;
+
+                case TokenValue::IMPLEMENTATION:
+                    if (isInterface)
+                    {
+                        return true;
+                    }
+
+                    errorReport("Unexpected implementation in the implementation part of unit.");
+                    return false;
+
+                case TokenValue::BEGIN:
+                case TokenValue::END:
+                    if (!isInterface)
+                    {
+                        return true;
+                    }
+
+                    errorReport("Expected implementation, but find " + scanner_.getToken().getTokenName());
+                    return false;
+
+                default:
+                    errorReport("Unexpected " + scanner_.getToken().getTokenName() + " in unit " +
+                                (isInterface ? "interface" : "implementation") + " part.");
+                    return false;
+            }
+
+            if (scanner_.getToken().getTokenType() == TokenType::END_OF_FILE)
+            {
+                errorReport("Unexpected end of file.");
+                return false;
+            }
+        }
     }
 
     BlockASTPtr Parser::parseBlockStatement()
     {
+        TimeTraceScope timeScope("ParseBlockStatement");
+
         auto loc = scanner_.getToken().getTokenLocation();
 
         if(!expectToken(TokenValue::BEGIN , "begin", true))
@@ -259,7 +447,8 @@ namespace llvmpascal
             {
                 stmts.push_back(std::move(stmt));
 
-                if (!expectToken(TokenValue::SEMICOLON, ";", true) || !expectToken(TokenValue::END, "end", true))
+                // statements are separated by ';', the last one may be followed by 'end' directly.
+                if (!validateToken(TokenValue::SEMICOLON, true) && !expectToken(TokenValue::END, "end", false))
                 {
                     return nullptr;
                 }
@@ -275,7 +464,14 @@ namespace llvmpascal
             return nullptr;
         }
 
-        return std::make_unique<BlockAST>(loc, stmts);
+        return std::make_unique<BlockAST>(loc, std::move(stmts));
+    }
+
+    PrototypeASTPtr Parser::parseFunctionDeclaration()
+    {
+        // TODO
+        assert(0 && "I have not implemented parseFunctionDeclaration.");
+        return nullptr;
     }
 
     FunctionASTPtr Parser::parseFunctionDefinition(int functionLevel)
@@ -317,6 +513,8 @@ namespace llvmpascal
     */
     void Parser::parseConstantDefinition()
     {
+        TimeTraceScope timeScope("ParseConstantDefinition");
+
         if (!expectToken(TokenValue::CONST, "const", true))
         {
             return;
@@ -539,8 +737,17 @@ namespace llvmpascal
         // every token has one token type whether it is keywords or constant value
         switch (token.getTokenType())
         {
-            // TODO:
-            // CHAR / INTEGER / REAL ... constant
+            case TokenType::INTEGER:
+                return parseIntegerExpression(token);
+
+            case TokenType::REAL:
+                return parseRealExpression(token);
+
+            case TokenType::CHAR:
+                return parseCharExpression(token);
+
+            case TokenType::STRING_LITERAL:
+                return parseStringExpression(token);
 
             // if token is keywords, if / while and so on
             case TokenType::KEYWORDS:
@@ -561,6 +768,10 @@ namespace llvmpascal
 
                     case TokenValue::CASE:
                         return parseCaseStatement();
+
+                    case TokenValue::WRITE:
+                    case TokenValue::WRITELN:
+                        return parseWrite();
                     // TODO:
                     // many others...
                     default:
@@ -607,11 +818,78 @@ namespace llvmpascal
         return token;
     }
 
+    // Operator precedence parsing, see the llvm kaleidoscope tutorial 02.
+    // The precedence of ':=' is 0 and it is not one binary operator
+    // of expression, so we stop at it and let parseStatement handle it.
+    // 'not' is one unary operator, we stop at it too.
     ExprASTPtr Parser::parseBinOpRHS(int precedence, ExprASTPtr lhs)
     {
-        // TODO:
-        assert(0 && "I have not implemented parseBinOpRHS.");
-        return nullptr;
+        for (;;)
+        {
+            const Token& opToken = scanner_.getToken();
+            int tokenPrecedence = opToken.getSymbolPrecedence();
+
+            if (tokenPrecedence <= 0 || opToken.getTokenValue() == TokenValue::NOT ||
+                tokenPrecedence < precedence)
+            {
+                return lhs;
+            }
+
+            TokenValue op = opToken.getTokenValue();
+            TokenLocation loc = opToken.getTokenLocation();
+            scanner_.getNextToken();
+
+            auto rhs = parsePrimary();
+
+            if (rhs == nullptr)
+            {
+                return nullptr;
+            }
+
+            // if op binds less tightly with rhs than the operator after rhs,
+            // let the pending operator take rhs as its lhs.
+            int nextPrecedence = scanner_.getToken().getSymbolPrecedence();
+
+            if (tokenPrecedence < nextPrecedence && scanner_.getToken().getTokenValue() != TokenValue::NOT)
+            {
+                rhs = parseBinOpRHS(tokenPrecedence + 1, std::move(rhs));
+
+                if (rhs == nullptr)
+                {
+                    return nullptr;
+                }
+            }
+
+            lhs = std::make_unique<BinaryExprAST>(loc, op, std::move(lhs), std::move(rhs));
+        }
+    }
+
+    ExprASTPtr Parser::parseIntegerExpression(const Token& token)
+    {
+        auto result = std::make_unique<IntegerExprAST>(token.getTokenLocation(), token.getIntValue());
+        scanner_.getNextToken();
+        return result;
+    }
+
+    ExprASTPtr Parser::parseRealExpression(const Token& token)
+    {
+        auto result = std::make_unique<RealExprAST>(token.getTokenLocation(), token.getRealValue());
+        scanner_.getNextToken();
+        return result;
+    }
+
+    ExprASTPtr Parser::parseCharExpression(const Token& token)
+    {
+        auto result = std::make_unique<CharExprAST>(token.getTokenLocation(), static_cast<char>(token.getIntValue()));
+        scanner_.getNextToken();
+        return result;
+    }
+
+    ExprASTPtr Parser::parseStringExpression(const Token& token)
+    {
+        auto result = std::make_unique<StringExprAST>(token.getTokenLocation(), token.getStringValue());
+        scanner_.getNextToken();
+        return result;
     }
 
     /*
@@ -692,6 +970,12 @@ namespace llvmpascal
     //                  {' ;' case-list-element} [';'] 'end'
     //case-list-element = case-constant-list ':' statement
     //case-index = expression
+    //
+    // We also support subrange labels and the otherwise part of
+    // extended Pascal (ISO 10206 6.9.3.5):
+    // case-constant = constant [ '..' constant ]
+    // case-statement = 'case' case-index 'of' case-list-element
+    //                  {' ;' case-list-element} [ [';'] 'otherwise' statement-sequence ] [';'] 'end'
 
     // For example
     /*
@@ -709,9 +993,192 @@ namespace llvmpascal
     */
     ExprASTPtr Parser::parseCaseStatement()
     {
-        // TODO:
-        assert(0 && "I have not implemented parseCaseStatement.");
-        return nullptr;
+        TokenLocation loc = scanner_.getToken().getTokenLocation();
+
+        if (!expectToken(TokenValue::CASE, "case", true))
+        {
+            return nullptr;
+        }
+
+        auto caseIndex = parseExpression();
+
+        if (!caseIndex)
+        {
+            errorReport("case index is not valid.");
+            return nullptr;
+        }
+
+        if (!expectToken(TokenValue::OF, "of", true))
+        {
+            return nullptr;
+        }
+
+        std::vector<CaseLabelRange> labels;
+        std::vector<TokenLocation> labelLocs;
+        VecExprASTPtr arms;
+        ExprASTPtr otherwisePart = nullptr;
+
+        while (!validateToken(TokenValue::END, false))
+        {
+            // many compilers (such as Free Pascal) use else, so we accept both.
+            if (validateToken(TokenValue::OTHERWISE, true) || validateToken(TokenValue::ELSE, true))
+            {
+                TokenLocation otherwiseLoc = scanner_.getToken().getTokenLocation();
+                VecExprASTPtr otherwiseStmts;
+
+                while (!validateToken(TokenValue::END, false))
+                {
+                    auto stmt = parseBlockOrStatement();
+
+                    if (!stmt)
+                    {
+                        return nullptr;
+                    }
+
+                    otherwiseStmts.push_back(std::move(stmt));
+
+                    if (!validateToken(TokenValue::END, false) && !expectToken(TokenValue::SEMICOLON, ";", true))
+                    {
+                        return nullptr;
+                    }
+                }
+
+                otherwisePart = std::make_unique<BlockAST>(otherwiseLoc, std::move(otherwiseStmts));
+                break;
+            }
+
+            // case-constant-list = case-constant { ',' case-constant }
+            do
+            {
+                TokenLocation labelLoc = scanner_.getToken().getTokenLocation();
+                long low = 0;
+
+                if (!parseCaseConstant(low))
+                {
+                    return nullptr;
+                }
+
+                long high = low;
+
+                if (validateToken(TokenValue::DOT_DOT, true))
+                {
+                    if (!parseCaseConstant(high))
+                    {
+                        return nullptr;
+                    }
+
+                    if (high < low)
+                    {
+                        errorReport("case label range " + std::to_string(low) + ".." + std::to_string(high) + " is empty.");
+                        return nullptr;
+                    }
+                }
+
+                labels.push_back(CaseLabelRange{ low, high, arms.size(), labelLocs.size() });
+                labelLocs.push_back(labelLoc);
+            } while (validateToken(TokenValue::COMMA, true));
+
+            if (!expectToken(TokenValue::COLON, ":", true))
+            {
+                return nullptr;
+            }
+
+            auto arm = parseBlockOrStatement();
+
+            if (!arm)
+            {
+                return nullptr;
+            }
+
+            arms.push_back(std::move(arm));
+
+            // the last case-list-element can have semicolon or not,
+            // the same before the otherwise part.
+            if (!validateToken(TokenValue::END, false) && !validateToken(TokenValue::OTHERWISE, false) &&
+                !validateToken(TokenValue::ELSE, false) && !expectToken(TokenValue::SEMICOLON, ";", true))
+            {
+                return nullptr;
+            }
+        }
+
+        // case-statement needs at least one case-list-element.
+        if (arms.empty())
+        {
+            errorReport("case statement must have at least one case label.");
+            return nullptr;
+        }
+
+        if (!expectToken(TokenValue::END, "end", true))
+        {
+            return nullptr;
+        }
+
+        CaseLowering lowering(std::move(labels));
+        std::size_t first = 0;
+        std::size_t second = 0;
+
+        if (lowering.findOverlap(first, second))
+        {
+            // report the label which comes later in the source.
+            const CaseLabelRange& firstLabel = lowering.getLabels()[first];
+            const CaseLabelRange& secondLabel = lowering.getLabels()[second];
+            const CaseLabelRange& duplicate = firstLabel.sourceIndex > secondLabel.sourceIndex ?
+                                              firstLabel : secondLabel;
+            errorReport(labelLocs[duplicate.sourceIndex], "case label " +
+                        std::to_string(std::max(firstLabel.low, secondLabel.low)) + " appears more than once.");
+            return nullptr;
+        }
+
+        return std::make_unique<CaseStatementAST>(loc, std::move(caseIndex), std::move(lowering),
+                                                  std::move(arms), std::move(otherwisePart));
+    }
+
+    // case-constant should be ordinal, i.e. [sign] integer or char.
+    bool Parser::parseCaseConstant(long& value)
+    {
+        int numberSign = 1;
+        bool hasNumberSign = false;
+
+        if (validateToken(TokenValue::MINUS, true))
+        {
+            numberSign = -1;
+            hasNumberSign = true;
+        }
+        else if (validateToken(TokenValue::PLUS, true))
+        {
+            hasNumberSign = true;
+        }
+
+        Token token = parseToken(scanner_.getToken());
+
+        switch (token.getTokenType())
+        {
+            case TokenType::INTEGER:
+                value = numberSign * token.getIntValue();
+                break;
+
+            case TokenType::CHAR:
+                if (hasNumberSign)
+                {
+                    errorReport("'+' or '-' can not be used in the char case label");
+                    return false;
+                }
+
+                value = token.getIntValue();
+                break;
+
+            case TokenType::IDENTIFIER:
+                // TODO: constant identifier and enumerated type label, after we have symbol table.
+                errorReport("Sorry, constant identifier case label " + token.getTokenName() + " is not supported now.");
+                return false;
+
+            default:
+                errorReport("Expected integer or char case label, but find " + token.getTokenName());
+                return false;
+        }
+
+        scanner_.getNextToken();
+        return true;
     }
 
     // 6.8.3.9 For-statements
@@ -739,6 +1206,7 @@ namespace llvmpascal
         }
 
         auto controlVariable = scanner_.getToken().getIdentifierName();
+        scanner_.getNextToken();
 
         if(!expectToken(TokenValue::ASSIGN, ":=", true))
         {
@@ -752,6 +1220,9 @@ namespace llvmpascal
             return nullptr;
         }
 
+        // read the directive state before the body, {$R-} inside
+        // the body does not change the check of this loop.
+        bool rangeCheckEnabled = scanner_.isRangeCheckEnabled();
         bool downOrder = false;
 
         if (validateToken(TokenValue::TO, false) ||
@@ -788,8 +1259,15 @@ namespace llvmpascal
             return nullptr;
         }
 
+        // TODO: the declared range of the control variable, after we have symbol table.
+        // Until then the loops are counted as not analyzed.
+        ValueRange controlRange = { 0, 0 };
+        RangeCheckKind rangeCheck = RangeCheck::analyzeForStatement(startExpr.get(), endExpr.get(), nullptr,
+                                                                    rangeCheckEnabled, controlRange);
+        RangeCheck::recordCheck(rangeCheck);
+
         return std::make_unique<ForStatementAST>(loc, controlVariable,
-            std::move(startExpr), std::move(endExpr), downOrder, std::move(body));
+            std::move(startExpr), std::move(endExpr), downOrder, std::move(body), rangeCheck, controlRange);
 
     }
 
@@ -884,7 +1362,7 @@ namespace llvmpascal
             return nullptr;
         }
 
-        return std::make_unique<RepeatStatementAST>(loc, std::move(condition), std::make_unique<BlockAST>(nestedLoc, nestedStmts));
+        return std::make_unique<RepeatStatementAST>(loc, std::move(condition), std::make_unique<BlockAST>(nestedLoc, std::move(nestedStmts)));
     }
 
 
@@ -895,15 +1373,228 @@ namespace llvmpascal
         return nullptr;
     }
 
+    // 6.7.1 set-constructor = '[' [ member-designator { ',' member-designator } ] ']' .
+    // member-designator = expression [ '..' expression ] .
+    //
+    // [Example]
+    //     [ ]
+    //     [ 1, 3..5, 'a' ]
+    //     [ i, j..k ]
+    // [/Example]
+    //
+    // Integer and char literal members are folded into one PascalSet now,
+    // so [1, 3..5] becomes one constant and 'x in [1, 3..5]' is one bit test.
     ExprASTPtr Parser::parseSetExpression()
     {
-        // TODO:
-        assert(0 && "I have not implemented parseSetExpression.");
-        return nullptr;
+        TokenLocation loc = scanner_.getToken().getTokenLocation();
+
+        if (!expectToken(TokenValue::LEFT_SQUARE, "[", true))
+        {
+            return nullptr;
+        }
+
+        PascalSet constantMembers;
+        std::vector<SetExpressionAST::MemberRange> members;
+
+        if (validateToken(TokenValue::RIGHT_SQUARE, true))
+        {
+            return std::make_unique<SetExpressionAST>(loc, constantMembers, std::move(members));
+        }
+
+        for (;;)
+        {
+            TokenLocation memberLoc = scanner_.getToken().getTokenLocation();
+            auto low = parseExpression();
+
+            if (low == nullptr)
+            {
+                return nullptr;
+            }
+
+            ExprASTPtr high = nullptr;
+
+            if (validateToken(TokenValue::DOT_DOT, true))
+            {
+                high = parseExpression();
+
+                if (high == nullptr)
+                {
+                    return nullptr;
+                }
+            }
+
+            long lowValue = 0;
+            long highValue = 0;
+
+            bool isConstant = getOrdinalLiteral(low.get(), lowValue);
+            highValue = lowValue;
+
+            if (isConstant && high != nullptr)
+            {
+                isConstant = getOrdinalLiteral(high.get(), highValue);
+            }
+
+            if (isConstant)
+            {
+                // low > high is one empty range, see pascal standard 6.7.1, it adds nothing.
+                // check the range while the values are still long, so the casts below can not truncate.
+                if (lowValue <= highValue)
+                {
+                    if (lowValue < PascalSet::minElement || highValue > PascalSet::maxElement)
+                    {
+                        errorReport("Set element value out of range " + std::to_string(PascalSet::minElement) +
+                                    ".." + std::to_string(PascalSet::maxElement) + " at " + memberLoc.toString());
+                        return nullptr;
+                    }
+
+                    constantMembers.insertRange(static_cast<int>(lowValue), static_cast<int>(highValue));
+                }
+            }
+            else
+            {
+                members.push_back(std::make_pair(std::move(low), std::move(high)));
+            }
+
+            if (validateToken(TokenValue::RIGHT_SQUARE, true))
+            {
+                break;
+            }
+
+            if (!expectToken(TokenValue::COMMA, ",", true))
+            {
+                return nullptr;
+            }
+        }
+
+        return std::make_unique<SetExpressionAST>(loc, constantMembers, std::move(members));
+    }
+
+    bool Parser::getOrdinalLiteral(const ExprAST* expr, long& value)
+    {
+        if (auto integerExpr = dynamic_cast<const IntegerExprAST*>(expr))
+        {
+            value = integerExpr->getValue();
+            return true;
+        }
+
+        if (auto charExpr = dynamic_cast<const CharExprAST*>(expr))
+        {
+            value = static_cast<unsigned char>(charExpr->getValue());
+            return true;
+        }
+
+        return false;
+    }
+
+    // integer, or not known until we have symbol table.
+    bool Parser::isIntegerWriteFormat(const ExprAST* expr)
+    {
+        WriteArgumentKind kind = WriteStatementAST::getArgumentKind(expr);
+        return kind == WriteArgumentKind::INTEGER || kind == WriteArgumentKind::UNKNOWN;
+    }
+
+    // 6.9.3 write-parameter-list = '(' [ file-variable ',' ] write-parameter
+    //                              { ',' write-parameter } ')' .
+    // write-parameter = expression [ ':' expression [ ':' expression ] ] .
+    // 6.9.4 writeln-parameter-list = [ '(' ( file-variable | write-parameter )
+    //                              { ',' write-parameter } ')' ] .
+    //
+    // [Example]
+    //     write('x = ', x : 8 : 2)
+    //     writeln
+    // [/Example]
+    //
+    // TODO: file-variable, after we have symbol table.
+    ExprASTPtr Parser::parseWrite()
+    {
+        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        bool newLine = scanner_.getToken().getTokenValue() == TokenValue::WRITELN;
+        std::vector<WriteArgument> arguments;
+
+        scanner_.getNextToken();
+
+        if (!validateToken(TokenValue::LEFT_PAREN, true))
+        {
+            if (!newLine)
+            {
+                errorReport("write needs at least one parameter.");
+                return nullptr;
+            }
+
+            return std::make_unique<WriteStatementAST>(loc, newLine, std::move(arguments));
+        }
+
+        do
+        {
+            WriteArgument argument{ parseExpression(), nullptr, nullptr, WriteArgumentKind::UNKNOWN };
+
+            if (argument.value == nullptr)
+            {
+                return nullptr;
+            }
+
+            TokenLocation precisionLoc;
+
+            if (validateToken(TokenValue::COLON, true))
+            {
+                TokenLocation widthLoc = scanner_.getToken().getTokenLocation();
+                argument.width = parseExpression();
+
+                if (argument.width == nullptr)
+                {
+                    return nullptr;
+                }
+
+                // 6.9.3.1 TotalWidth and FracDigits are integer expressions.
+                if (!isIntegerWriteFormat(argument.width.get()))
+                {
+                    errorReport(widthLoc, "Field width of write parameter must be integer.");
+                    return nullptr;
+                }
+
+                if (validateToken(TokenValue::COLON, true))
+                {
+                    precisionLoc = scanner_.getToken().getTokenLocation();
+                    argument.precision = parseExpression();
+
+                    if (argument.precision == nullptr)
+                    {
+                        return nullptr;
+                    }
+
+                    if (!isIntegerWriteFormat(argument.precision.get()))
+                    {
+                        errorReport(precisionLoc, "Fraction digits of write parameter must be integer.");
+                        return nullptr;
+                    }
+                }
+            }
+
+            argument.kind = WriteStatementAST::getArgumentKind(argument.value.get());
+
+            // 6.9.3.1 only real-type write parameter can have fraction digits.
+            if (argument.precision != nullptr && argument.kind != WriteArgumentKind::REAL &&
+                argument.kind != WriteArgumentKind::UNKNOWN)
+            {
+                errorReport(precisionLoc, "Only real write parameter can have fraction digits.");
+                return nullptr;
+            }
+
+            arguments.push_back(std::move(argument));
+        } while (validateToken(TokenValue::COMMA, true));
+
+        if (!expectToken(TokenValue::RIGHT_PAREN, ")", true))
+        {
+            return nullptr;
+        }
+
+        return std::make_unique<WriteStatementAST>(loc, newLine, std::move(arguments));
     }
 
     ExprASTPtr Parser::parseStatement()
     {
+        TimeTraceScope timeScope("ParseStatement");
+
         if(auto expr = parsePrimary())
         {
             if(validateToken(TokenValue::ASSIGN, true))
@@ -1023,6 +1714,11 @@ namespace llvmpascal
 
     void Parser::errorReport(const std::string& msg)
     {
-        errorSyntax(scanner_.getToken().getTokenLocation().toString() + msg);
+        errorReport(scanner_.getToken().getTokenLocation(), msg);
+    }
+
+    void Parser::errorReport(const TokenLocation& loc, const std::string& msg)
+    {
+        errorSyntax(loc.toString() + msg);
     }
 }
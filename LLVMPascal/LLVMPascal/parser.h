@@ -48,13 +48,14 @@ namespace llvmpascal
         // parse different type expressions.
         // they are also very like parseNumber function in the llvm tutorial,
         // but they are more complex
-        ExprASTPtr            parseRealExpression(Token token);
-        ExprASTPtr            parseIntegerExpression(Token token);
-        ExprASTPtr            parseCharExpression(Token token);
-        ExprASTPtr            parseStringExpression(Token token);
+        ExprASTPtr            parseRealExpression(const Token& token);
+        ExprASTPtr            parseIntegerExpression(const Token& token);
+        ExprASTPtr            parseCharExpression(const Token& token);
+        ExprASTPtr            parseStringExpression(const Token& token);
 
         // set, array, filed, pointer type expression to implementation.
         ExprASTPtr            parseSetExpression();
+        bool                  getOrdinalLiteral(const ExprAST* expr, long& value);
 
         // see pascal standard 6.8
         
@@ -62,12 +63,18 @@ namespace llvmpascal
         ExprASTPtr            parseStatement(); 
         ExprASTPtr            parseIfStatement();
         ExprASTPtr            parseCaseStatement();
+        bool                  parseCaseConstant(long& value);
         ExprASTPtr            parseRepeatStatement();
         ExprASTPtr            parseWhileStatement();
         ExprASTPtr            parseForStatement();
         ExprASTPtr            parseWithStatement();
         ExprASTPtr            parseProgramStatement();
 
+        // units, see parser.cpp
+        VecExprASTPtr&        parseUnit();
+        bool                  parseUsesClause(std::vector<std::string>& unitNames);
+        bool                  parseUnitDeclarations(bool isInterface);
+
         ExprASTPtr            parseGotoStatement();// TODO: Maybe I will not implement it.
 
         BlockASTPtr           parseBlockStatement(); // begin...end
@@ -76,13 +83,14 @@ namespace llvmpascal
         // declaration / definition contains procedure and function.
         // see pascal standard 6.7 and 6.8
         // also see the link: http://pascal-programming.info/lesson7.php
-        PrototypeASTPtr       parseFunctionDeclaration(bool isFunction = true);
+        PrototypeASTPtr       parseFunctionDeclaration();
         FunctionASTPtr        parseFunctionDefinition(int functionLevel);
         VarDeclASTPtr         parseVariableDeclaration();
 
         // I/O routines
         ExprASTPtr            parseRead();
         ExprASTPtr            parseWrite();
+        bool                  isIntegerWriteFormat(const ExprAST* expr);
 
         // Type
         void                  parseTypeDefinition();
@@ -99,6 +107,7 @@ namespace llvmpascal
         bool                  validateToken(TokenValue value, bool advanceToNextToken);
         bool                  validateToken(TokenType type, bool advanceToNextToken);
         void                  errorReport(const std::string& msg);
+        void                  errorReport(const TokenLocation& loc, const std::string& msg);
     private:
         Scanner&              scanner_;
         VecExprASTPtr         ast_;
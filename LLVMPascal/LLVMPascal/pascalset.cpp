@@ -0,0 +1,80 @@
+#include "pascalset.h"
+
+namespace llvmpascal
+{
+    PascalSet::PascalSet()
+        : words_{ 0, 0, 0, 0 }
+    {}
+
+    void PascalSet::insertRange(int low, int high)
+    {
+        if (low < minElement)
+        {
+            low = minElement;
+        }
+
+        if (high > maxElement)
+        {
+            high = maxElement;
+        }
+
+        for (int element = low; element <= high; ++element)
+        {
+            insert(element);
+        }
+    }
+
+    int PascalSet::size() const
+    {
+        int count = 0;
+
+        for (int i = 0; i < wordCount; ++i)
+        {
+            // clear the lowest bit each time.
+            for (std::uint64_t word = words_[i]; word != 0; word &= word - 1)
+            {
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    std::string PascalSet::toString() const
+    {
+        std::string result = "[";
+        int element = minElement;
+
+        while (element <= maxElement)
+        {
+            if (!contains(element))
+            {
+                element++;
+                continue;
+            }
+
+            int last = element;
+
+            while (last + 1 <= maxElement && contains(last + 1))
+            {
+                last++;
+            }
+
+            if (result.size() > 1)
+            {
+                result += ", ";
+            }
+
+            result += std::to_string(element);
+
+            if (last > element)
+            {
+                result += ".." + std::to_string(last);
+            }
+
+            element = last + 1;
+        }
+
+        return result + "]";
+    }
+}
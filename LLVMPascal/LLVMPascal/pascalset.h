@@ -0,0 +1,147 @@
+#ifndef PASCALSET_H_
+#define PASCALSET_H_
+
+#include <cstdint>
+#include <string>
+
+namespace llvmpascal
+{
+    // Value of Pascal set type, see pascal standard 6.4.3.4 and 6.7.2.4.
+    // set of char and set of small subrange / enumerated types are
+    // represented as one fixed 256 bits bitset, i.e. the element range
+    // is 0..255 (like Free Pascal and Turbo Pascal).
+    //
+    // Every operator is one loop over four 64 bits words without branches,
+    // compilers make them SSE / AVX instructions (two 128 bits or one 256
+    // bits operation), and 'in' is one bit test.
+    //
+    // [1, 3] + [5]   union
+    // [1, 3] * [3]   intersection
+    // [1, 3] - [3]   difference
+    // [1] <= [1, 3]  inclusion
+    // 3 in [1, 3]    membership
+    class PascalSet
+    {
+    public:
+        static const int  minElement = 0;
+        static const int  maxElement = 255;
+        static const int  wordCount = 4;
+
+        PascalSet();
+
+        void              insert(int element);
+        void              insertRange(int low, int high);
+        bool              contains(int element) const;
+        bool              isEmpty() const;
+        int               size() const;
+
+        PascalSet         operator+(const PascalSet& rhs) const;
+        PascalSet         operator*(const PascalSet& rhs) const;
+        PascalSet         operator-(const PascalSet& rhs) const;
+        bool              operator==(const PascalSet& rhs) const;
+        bool              operator!=(const PascalSet& rhs) const;
+        bool              operator<=(const PascalSet& rhs) const;
+        bool              operator>=(const PascalSet& rhs) const;
+
+        // such as [1, 3..5, 7]
+        std::string       toString() const;
+
+    private:
+        std::uint64_t     words_[wordCount];
+    };
+
+    inline bool PascalSet::contains(int element) const
+    {
+        unsigned index = static_cast<unsigned>(element);
+        return index <= maxElement && ((words_[index >> 6] >> (index & 63)) & 1);
+    }
+
+    inline void PascalSet::insert(int element)
+    {
+        unsigned index = static_cast<unsigned>(element);
+
+        if (index <= maxElement)
+        {
+            words_[index >> 6] |= std::uint64_t(1) << (index & 63);
+        }
+    }
+
+    inline PascalSet PascalSet::operator+(const PascalSet& rhs) const
+    {
+        PascalSet result;
+
+        for (int i = 0; i < wordCount; ++i)
+        {
+            result.words_[i] = words_[i] | rhs.words_[i];
+        }
+
+        return result;
+    }
+
+    inline PascalSet PascalSet::operator*(const PascalSet& rhs) const
+    {
+        PascalSet result;
+
+        for (int i = 0; i < wordCount; ++i)
+        {
+            result.words_[i] = words_[i] & rhs.words_[i];
+        }
+
+        return result;
+    }
+
+    inline PascalSet PascalSet::operator-(const PascalSet& rhs) const
+    {
+        PascalSet result;
+
+        for (int i = 0; i < wordCount; ++i)
+        {
+            result.words_[i] = words_[i] & ~rhs.words_[i];
+        }
+
+        return result;
+    }
+
+    // use | and & to combine the words rather than && and ||,
+    // so there is no early exit branch and the loop can be vectorized.
+    inline bool PascalSet::operator==(const PascalSet& rhs) const
+    {
+        std::uint64_t difference = 0;
+
+        for (int i = 0; i < wordCount; ++i)
+        {
+            difference |= words_[i] ^ rhs.words_[i];
+        }
+
+        return difference == 0;
+    }
+
+    inline bool PascalSet::operator!=(const PascalSet& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    inline bool PascalSet::operator<=(const PascalSet& rhs) const
+    {
+        std::uint64_t outside = 0;
+
+        for (int i = 0; i < wordCount; ++i)
+        {
+            outside |= words_[i] & ~rhs.words_[i];
+        }
+
+        return outside == 0;
+    }
+
+    inline bool PascalSet::operator>=(const PascalSet& rhs) const
+    {
+        return rhs <= *this;
+    }
+
+    inline bool PascalSet::isEmpty() const
+    {
+        return (words_[0] | words_[1] | words_[2] | words_[3]) == 0;
+    }
+}
+
+#endif // pascalset.h
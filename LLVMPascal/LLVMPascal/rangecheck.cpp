@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include "rangecheck.h"
+#include "ast.h"
+
+namespace llvmpascal
+{
+    long RangeCheck::counters_[4] = { 0, 0, 0, 0 };
+
+    namespace
+    {
+        // give up if the result does not fit long,
+        // the expression is not in bounds for any subrange then.
+        bool checkedResult(long double value, long& result)
+        {
+            if (value < static_cast<long double>(std::numeric_limits<long>::min()) ||
+                value > static_cast<long double>(std::numeric_limits<long>::max()))
+            {
+                return false;
+            }
+
+            result = static_cast<long>(value);
+            return true;
+        }
+
+        bool addRange(const ValueRange& lhs, const ValueRange& rhs, ValueRange& result)
+        {
+            return checkedResult(static_cast<long double>(lhs.low) + rhs.low, result.low) &&
+                   checkedResult(static_cast<long double>(lhs.high) + rhs.high, result.high);
+        }
+
+        bool subtractRange(const ValueRange& lhs, const ValueRange& rhs, ValueRange& result)
+        {
+            return checkedResult(static_cast<long double>(lhs.low) - rhs.high, result.low) &&
+                   checkedResult(static_cast<long double>(lhs.high) - rhs.low, result.high);
+        }
+
+        // the smallest and the largest of the four corner products.
+        bool multiplyRange(const ValueRange& lhs, const ValueRange& rhs, ValueRange& result)
+        {
+            long double products[] =
+            {
+                static_cast<long double>(lhs.low) * rhs.low,
+                static_cast<long double>(lhs.low) * rhs.high,
+                static_cast<long double>(lhs.high) * rhs.low,
+                static_cast<long double>(lhs.high) * rhs.high
+            };
+
+            return checkedResult(*std::min_element(products, products + 4), result.low) &&
+                   checkedResult(*std::max_element(products, products + 4), result.high);
+        }
+    }
+
+    bool RangeCheck::evaluateRange(const ExprAST* expr, ValueRange& range)
+    {
+        if (auto integerExpr = dynamic_cast<const IntegerExprAST*>(expr))
+        {
+            range.low = range.high = integerExpr->getValue();
+            return true;
+        }
+
+        if (auto charExpr = dynamic_cast<const CharExprAST*>(expr))
+        {
+            range.low = range.high = static_cast<unsigned char>(charExpr->getValue());
+            return true;
+        }
+
+        // TODO: variables of subrange types, after we have symbol table.
+        auto binaryExpr = dynamic_cast<const BinaryExprAST*>(expr);
+
+        if (binaryExpr == nullptr)
+        {
+            return false;
+        }
+
+        ValueRange lhs;
+        ValueRange rhs;
+
+        if (!evaluateRange(binaryExpr->getLHS(), lhs) || !evaluateRange(binaryExpr->getRHS(), rhs))
+        {
+            return false;
+        }
+
+        switch (binaryExpr->getOp())
+        {
+            case TokenValue::PLUS:
+                return addRange(lhs, rhs, range);
+
+            case TokenValue::MINUS:
+                return subtractRange(lhs, rhs, range);
+
+            case TokenValue::MULTIPLY:
+                return multiplyRange(lhs, rhs, range);
+
+            default:
+                return false;
+        }
+    }
+
+    RangeCheckKind RangeCheck::analyzeForStatement(const ExprAST* startExpr, const ExprAST* endExpr,
+                                                   const ValueRange* declaredRange, bool enabled,
+                                                   ValueRange& controlRange)
+    {
+        if (!enabled)
+        {
+            return RangeCheckKind::DISABLED;
+        }
+
+        // without the declared range there is nothing to compare with,
+        // such as one integer control variable which needs no check at all.
+        if (declaredRange == nullptr)
+        {
+            return RangeCheckKind::NOT_ANALYZED;
+        }
+
+        ValueRange startRange;
+        ValueRange endRange;
+
+        if (!evaluateRange(startExpr, startRange) || !evaluateRange(endExpr, endRange))
+        {
+            return RangeCheckKind::HOISTED;
+        }
+
+        // the body is not executed if the loop is empty, so the union
+        // of both bounds is safe for to and downto loops.
+        controlRange.low = std::min(startRange.low, endRange.low);
+        controlRange.high = std::max(startRange.high, endRange.high);
+
+        if (controlRange.low < declaredRange->low || controlRange.high > declaredRange->high)
+        {
+            return RangeCheckKind::HOISTED;
+        }
+
+        return RangeCheckKind::ELIMINATED;
+    }
+
+    void RangeCheck::recordCheck(RangeCheckKind kind)
+    {
+        counters_[static_cast<int>(kind)]++;
+    }
+
+    void RangeCheck::printReport(std::ostream& out)
+    {
+        static const char* names[] = { "disabled ({$R-})", "eliminated", "hoisted out of loops",
+                                       "not analyzed" };
+        long total = counters_[0] + counters_[1] + counters_[2] + counters_[3];
+
+        out << "===-------------------------------------------------------------------------===\n"
+            << "                          Range check report\n"
+            << "===-------------------------------------------------------------------------===\n";
+
+        for (int i = 0; i < 4; ++i)
+        {
+            out << "  " << std::left << std::setw(24) << names[i]
+                << std::right << std::setw(10) << counters_[i] << '\n';
+        }
+
+        out << "  " << std::left << std::setw(24) << "total"
+            << std::right << std::setw(10) << total << '\n';
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef RANGECHECK_H_
+#define RANGECHECK_H_
+
+#include <ostream>
+
+namespace llvmpascal
+{
+    class ExprAST;
+
+    // all values one ordinal expression can have, [low, high].
+    struct ValueRange
+    {
+        long         low;
+        long         high;
+    };
+
+    // what code generation does for the range checks of one statement.
+    enum class RangeCheckKind
+    {
+        DISABLED,      // {$R-}, no check
+        ELIMINATED,    // proven in bounds at compile time, no check
+        HOISTED,       // checked once before the loop instead of every iteration
+        NOT_ANALYZED   // the declared range is not known, checked as usual
+    };
+
+    // Range check elimination. Pascal requires the value assigned to one
+    // subrange variable (and the array index) to be in its range, see pascal
+    // standard 6.4.2.4 and 6.5.3.2. Checking every assignment is expensive in
+    // numeric loops, so we prove what we can when we parse:
+    //
+    // 1. interval arithmetic over the expression gives its range, such as
+    //    [2 * 3 + 1, 2 * 3 + 1] or [1, 10] + [0, 1] = [1, 11].
+    // 2. the control variable of one for statement can not be modified by
+    //    the body (6.8.3.9), and moves from the initial value to the final
+    //    value one by one. So checking the two bounds once before the loop
+    //    is enough, i.e. the check is hoisted out of the loop. If both bounds
+    //    are known and inside the declared range of the control variable,
+    //    there is no check at all.
+    //
+    // {$R-} / {$R+} (or {$RANGECHECKS OFF} / {$RANGECHECKS ON}) turn range
+    // checks off and on from that point of the source file.
+    class RangeCheck
+    {
+    public:
+        // false if the range of expr is not known at compile time.
+        static bool            evaluateRange(const ExprAST* expr, ValueRange& range);
+
+        // declaredRange is the range of the control variable's type, null if it is
+        // not known. controlRange is the range of the control variable if it is proven.
+        static RangeCheckKind  analyzeForStatement(const ExprAST* startExpr, const ExprAST* endExpr,
+                                                   const ValueRange* declaredRange, bool enabled,
+                                                   ValueRange& controlRange);
+
+        // statistics for -frange-check-report
+        static void            recordCheck(RangeCheckKind kind);
+        static void            printReport(std::ostream& out);
+
+    private:
+        static long            counters_[4];
+    };
+}
+
+#endif // rangecheck.h
@@ -12,8 +12,17 @@
 
 #include <algorithm>
 #include <cctype>
+#include <utility>
 #include "scanner.h"
 #include "error.h"
+#include "timetrace.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 
 namespace llvmpascal
@@ -21,20 +30,130 @@ namespace llvmpascal
     bool Scanner::errorFlag_ = false;
 
     Scanner::Scanner(const std::string& srcFileName)
-        : fileName_(srcFileName), line_(1), column_(0),
-          currentChar_(0), state_(State::NONE)
+        : fileName_(srcFileName), mapping_(nullptr), mappingSize_(0),
+          current_(nullptr), end_(nullptr), eof_(false),
+          line_(1), column_(0), currentChar_(0), state_(State::NONE), rangeCheck_(true)
+    {
+        if (!mapSource())
+        {
+            readSource();
+        }
+    }
+
+    Scanner::~Scanner()
     {
-        input_.open(fileName_);
+        releaseSource();
+    }
+
+    // map regular files on POSIX systems, so there is no copy of the file at
+    // all and pages are read by the kernel when we first touch them.
+    // Empty files, pipes and other special files can not be mapped,
+    // we read them with readSource. Check the path before opening it:
+    // a pipe can only be read once, so it must be opened only by readSource.
+    bool Scanner::mapSource()
+    {
+#ifdef _WIN32
+        // TODO: CreateFileMapping / MapViewOfFile. Read it now.
+        return false;
+#else
+        struct stat fileStatus;
 
-        if (input_.fail())
+        if (::stat(fileName_.c_str(), &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode))
+        {
+            return false;
+        }
+
+        int fd = ::open(fileName_.c_str(), O_RDONLY);
+
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        void* mapping = MAP_FAILED;
+
+        // the file may have changed since stat, use the size of what we opened.
+        if (::fstat(fd, &fileStatus) == 0 && S_ISREG(fileStatus.st_mode) && fileStatus.st_size > 0)
+        {
+            mapping = ::mmap(nullptr, static_cast<std::size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+
+        // the mapping keeps its own reference to the file.
+        ::close(fd);
+
+        if (mapping == MAP_FAILED)
+        {
+            return false;
+        }
+
+        mapping_ = mapping;
+        mappingSize_ = static_cast<std::size_t>(fileStatus.st_size);
+        ::madvise(mapping_, mappingSize_, MADV_SEQUENTIAL);
+
+        current_ = static_cast<const char*>(mapping_);
+        end_ = current_ + mappingSize_;
+        return true;
+#endif
+    }
+
+    void Scanner::releaseSource()
+    {
+#ifndef _WIN32
+        if (mapping_ != nullptr)
+        {
+            ::munmap(mapping_, mappingSize_);
+        }
+#endif
+        mapping_ = nullptr;
+        mappingSize_ = 0;
+        source_.clear();
+        source_.shrink_to_fit();
+        current_ = end_ = nullptr;
+    }
+
+    // read the whole file in large blocks instead of one istream::get call
+    // for every char. Source files are small compared with the memory
+    // the compiler uses anyway.
+    void Scanner::readSource()
+    {
+        std::ifstream input(fileName_, std::ios::in | std::ios::binary);
+
+        if (input.fail())
         {
             errorReport("When trying to open file " + fileName_ + ", occurred error.");
         }
+        else
+        {
+            // the size of pipes is not known, so read 64 KB blocks until the end.
+            const std::size_t blockSize = 64 * 1024;
+            std::size_t size = 0;
+
+            do
+            {
+                source_.resize(size + blockSize);
+                input.read(&source_[size], blockSize);
+                size += static_cast<std::size_t>(input.gcount());
+            } while (input);
+
+            source_.resize(size);
+        }
+
+        current_ = source_.data();
+        end_ = current_ + source_.size();
     }
 
     void Scanner::getNextChar()
     {
-        currentChar_ = input_.get();
+        // the same as istream::get, return EOF after the last char.
+        if (current_ != end_)
+        {
+            currentChar_ = *current_++;
+        }
+        else
+        {
+            currentChar_ = std::char_traits<char>::to_char_type(std::char_traits<char>::eof());
+            eof_ = true;
+        }
 
         if (currentChar_ == '\n')
         {
@@ -49,8 +168,8 @@ namespace llvmpascal
 
     char Scanner::peekChar()
     {
-        char c = input_.peek();
-        return c;
+        return current_ != end_ ? *current_ :
+               std::char_traits<char>::to_char_type(std::char_traits<char>::eof());
     }
 
 
@@ -71,7 +190,7 @@ namespace llvmpascal
     void Scanner::makeToken(TokenType tt, TokenValue tv,
                             const TokenLocation& loc, std::string name, int symbolPrecedence)
     {
-        token_ = Token(tt, tv, loc, name, symbolPrecedence);
+        token_ = Token(tt, tv, loc, std::move(name), symbolPrecedence);
         buffer_.clear();
         state_ = State::NONE;
     }
@@ -79,7 +198,7 @@ namespace llvmpascal
     void Scanner::makeToken(TokenType tt, TokenValue tv,
                             const TokenLocation& loc, long intValue, std::string name)
     {
-        token_ = Token(tt, tv, loc, intValue, name);
+        token_ = Token(tt, tv, loc, intValue, std::move(name));
         buffer_.clear();
         state_ = State::NONE;
     }
@@ -87,7 +206,7 @@ namespace llvmpascal
     void Scanner::makeToken(TokenType tt, TokenValue tv,
                             const TokenLocation& loc, double realValue, std::string name)
     {
-        token_ = Token(tt, tv, loc, realValue, name);
+        token_ = Token(tt, tv, loc, realValue, std::move(name));
         buffer_.clear();
         state_ = State::NONE;
     }
@@ -95,7 +214,7 @@ namespace llvmpascal
     void Scanner::makeToken(TokenType tt, TokenValue tv,
                             const TokenLocation& loc, const std::string& strValue, std::string name)
     {
-        token_ = Token(tt, tv, loc, strValue, name);
+        token_ = Token(tt, tv, loc, strValue, std::move(name));
         buffer_.clear();
         state_ = State::NONE;
     }
@@ -126,25 +245,39 @@ namespace llvmpascal
             // currentChar is * and eat it, update currentChar_ to the next char.
             getNextChar();
 
+            // only keep the content of directives, such as (*$R-*)
+            bool isDirective = currentChar_ == '$';
+            std::string directive;
+
             while (!(currentChar_ == '*' && peekChar() == ')'))
             {
+                if (isDirective)
+                {
+                    directive.push_back(currentChar_);
+                }
+
                 // skip comment content
                 getNextChar();
 
                 // accident EOF
-                if (input_.eof())
+                if (isEndOfFile())
                 {
                     errorReport(std::string("end of file happended in comment, *) is expected!, but find ") + currentChar_);
                     break;
                 }
             }
 
-            if (!input_.eof())
+            if (!isEndOfFile())
             {
                 // eat * and update currentChar_ to (
                 getNextChar();
                 // eat ) and update currentChar_ to the next Char
                 getNextChar();
+
+                if (isDirective)
+                {
+                    handleDirective(directive);
+                }
             }
         }
     }
@@ -155,27 +288,90 @@ namespace llvmpascal
 
         if (currentChar_ == '{')
         {
+            // only keep the content of directives, such as {$R-}
+            bool isDirective = peekChar() == '$';
+            std::string directive;
+
             do
             {
                 getNextChar();
 
-                if (input_.eof())
+                if (isEndOfFile())
                 {
                     errorReport(std::string("end of file happended in comment, } is expected!, but find ") + currentChar_);
                     break;
                 }
+
+                if (isDirective && currentChar_ != '}')
+                {
+                    directive.push_back(currentChar_);
+                }
             } while (currentChar_ != '}');
 
-            if (!input_.eof())
+            if (!isEndOfFile())
             {
                 // eat } and update currentChar_
                 getNextChar();
+
+                if (isDirective)
+                {
+                    handleDirective(directive);
+                }
+            }
+        }
+    }
+
+    // Compiler directives, like Turbo Pascal / Free Pascal.
+    // directive is the comment content, such as $R- or $R+,I- or
+    // $RANGECHECKS OFF. Unknown directives are ignored.
+    void Scanner::handleDirective(const std::string& directive)
+    {
+        std::string text;
+
+        for (char c : directive)
+        {
+            if (!std::isspace(static_cast<unsigned char>(c)))
+            {
+                text.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+            }
+        }
+
+        if (text == "$RANGECHECKSON")
+        {
+            rangeCheck_ = true;
+            return;
+        }
+
+        if (text == "$RANGECHECKSOFF")
+        {
+            rangeCheck_ = false;
+            return;
+        }
+
+        // switch directives: $R-  $R+,I-
+        std::string::size_type pos = 1;
+
+        while (pos + 1 < text.size())
+        {
+            if (text[pos] == 'R' && (text[pos + 1] == '+' || text[pos + 1] == '-'))
+            {
+                rangeCheck_ = text[pos + 1] == '+';
             }
+
+            pos = text.find(',', pos);
+
+            if (pos == std::string::npos)
+            {
+                break;
+            }
+
+            pos++;
         }
     }
 
-    Token Scanner::getNextToken()
+    const Token& Scanner::getNextToken()
     {
+        TimeTraceScope timeScope("GetNextToken");
         bool matched = false;
 
         do
@@ -220,7 +416,7 @@ namespace llvmpascal
             {
                 preprocess();
 
-                if (input_.eof())
+                if (isEndOfFile())
                 {
                     state_ = State::END_OF_FILE;
                 }
@@ -256,8 +452,8 @@ namespace llvmpascal
         loc_ = getTokenLocation();
         makeToken(TokenType::END_OF_FILE, TokenValue::UNRESERVED,
                   loc_, std::string("END_OF_FILE"), -1);
-        // close the file
-        input_.close();
+        // release the source
+        releaseSource();
     }
 
 
@@ -321,7 +517,9 @@ namespace llvmpascal
             }
 
             // change number state
-            if (currentChar_ == '.')
+            // Note: 1..10 is one subrange, so '..' after digits is the
+            // DOT_DOT token, not a fraction.
+            if (currentChar_ == '.' && peekChar() != '.')
             {
                 // first time, isFloat is false.
                 // But maybe enter float number state again, such as 12.4.5
@@ -405,6 +603,12 @@ namespace llvmpascal
                 }
             }
 
+            if (isEndOfFile())
+            {
+                errorReport("end of file happended in string literal, ' is expected!");
+                break;
+            }
+
             addToBuffer(currentChar_);
             getNextChar();
         }
@@ -25,14 +25,25 @@ namespace llvmpascal
     {
       public:
         explicit        Scanner(const std::string& srcFileName);
-        Token           getToken() const;
-        Token           getNextToken();
+                        ~Scanner();
+                        Scanner(const Scanner&) = delete;
+        Scanner&        operator=(const Scanner&) = delete;
+        // the reference is valid until the next getNextToken call.
+        const Token&    getToken() const;
+        const Token&    getNextToken();
         static bool     getErrorFlag();
         static void     setErrorFlag(bool flag);
 
+        // {$R+} / {$R-} state at the current token.
+        bool            isRangeCheckEnabled() const;
+
       private:
         void            getNextChar();
         char            peekChar();
+        bool            isEndOfFile() const;
+        bool            mapSource();
+        void            readSource();
+        void            releaseSource();
         void            addToBuffer(char c);
         void            reduceBuffer();
 
@@ -55,6 +66,7 @@ namespace llvmpascal
         void            preprocess();
         void            handleLineComment();
         void            handleBlockComment();
+        void            handleDirective(const std::string& directive);
         TokenLocation   getTokenLocation() const;
 
         void            handleDigit();
@@ -76,7 +88,15 @@ namespace llvmpascal
 
       private:
         std::string         fileName_;
-        std::ifstream       input_;
+        // the whole source file is mapped (or read) into memory once,
+        // then getNextChar / peekChar are just pointer operations.
+        // mapping_ is nullptr if the file is read into source_.
+        std::string         source_;
+        void*               mapping_;
+        std::size_t         mappingSize_;
+        const char*         current_;
+        const char*         end_;
+        bool                eof_;
         long                line_;
         long                column_;
         TokenLocation       loc_;
@@ -85,15 +105,26 @@ namespace llvmpascal
         Token               token_;
         Dictionary          dictionary_;
         std::string         buffer_;
+        bool                rangeCheck_;
         static bool         errorFlag_;
 
     };
 
-    inline Token Scanner::getToken() const
+    inline const Token& Scanner::getToken() const
     {
         return token_;
     }
 
+    inline bool Scanner::isEndOfFile() const
+    {
+        return eof_;
+    }
+
+    inline bool Scanner::isRangeCheckEnabled() const
+    {
+        return rangeCheck_;
+    }
+
     inline bool Scanner::getErrorFlag()
     {
         return errorFlag_;
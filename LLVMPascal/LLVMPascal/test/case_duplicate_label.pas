@@ -0,0 +1,7 @@
+program caseduplicate;
+begin
+  case 2 of
+    3: writeln(1);
+    1..10: writeln(2)
+  end
+end.
@@ -0,0 +1,5 @@
+program caseempty;
+begin
+  case 2 of
+  end
+end.
@@ -0,0 +1,12 @@
+program caseotherwise;
+begin
+  case 2 of
+    1: writeln(1)
+    otherwise writeln(2)
+  end;
+  case 'b' of
+    'a', 'b': writeln(1);
+    'c'..'z': writeln(2)
+    else writeln(3)
+  end
+end.
@@ -0,0 +1,137 @@
+#include <cstddef>
+#include <vector>
+#include "caselowering.h"
+#include "unittest.h"
+
+using namespace llvmpascal;
+using namespace llvmpascal::unittest;
+
+namespace
+{
+    // one label per arm, source order is the order of the vector.
+    std::vector<CaseLabelRange> makeLabels(const std::vector<std::pair<long, long>>& ranges)
+    {
+        std::vector<CaseLabelRange> labels;
+
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+        {
+            labels.push_back(CaseLabelRange{ ranges[i].first, ranges[i].second, i, i });
+        }
+
+        return labels;
+    }
+
+    void testSortsLabels()
+    {
+        CaseLowering lowering(makeLabels({ { 30, 30 }, { 10, 10 }, { 20, 20 } }));
+        const auto& labels = lowering.getLabels();
+
+        check(labels.size() == 3, "sort: label count");
+        check(labels[0].low == 10 && labels[1].low == 20 && labels[2].low == 30, "sort: labels sorted by low");
+        check(labels[0].sourceIndex == 1, "sort: source index is kept");
+    }
+
+    void testJumpTable()
+    {
+        // 0..9 with ten different arms: dense, too many targets for one bit test.
+        std::vector<std::pair<long, long>> ranges;
+
+        for (long i = 0; i < 10; ++i)
+        {
+            ranges.push_back({ i, i });
+        }
+
+        CaseLowering lowering(makeLabels(ranges));
+        const auto& clusters = lowering.getClusters();
+
+        check(clusters.size() == 1, "jump table: one cluster");
+        check(clusters[0].kind == CaseClusterKind::JUMP_TABLE, "jump table: kind");
+        check(clusters[0].low == 0 && clusters[0].high == 9, "jump table: range");
+        check(clusters[0].firstLabel == 0 && clusters[0].lastLabel == 9, "jump table: labels");
+    }
+
+    void testBitTest()
+    {
+        // six labels in one machine word, but only two arms.
+        std::vector<CaseLabelRange> labels;
+        const long values[] = { 1, 5, 9, 13, 17, 21 };
+
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            labels.push_back(CaseLabelRange{ values[i], values[i], i % 2, i });
+        }
+
+        CaseLowering lowering(labels);
+        const auto& clusters = lowering.getClusters();
+
+        check(clusters.size() == 1, "bit test: one cluster");
+        check(clusters[0].kind == CaseClusterKind::BIT_TEST, "bit test: kind");
+        check(clusters[0].low == 1 && clusters[0].high == 21, "bit test: range");
+    }
+
+    void testSparseLabels()
+    {
+        // far apart labels stay single comparisons.
+        CaseLowering lowering(makeLabels({ { 1, 1 }, { 1000, 1000 }, { 100000, 100000 } }));
+        const auto& clusters = lowering.getClusters();
+
+        check(clusters.size() == 3, "sparse: three clusters");
+
+        for (const auto& cluster : clusters)
+        {
+            check(cluster.kind == CaseClusterKind::RANGE, "sparse: kind");
+        }
+    }
+
+    void testFullLongRange()
+    {
+        // the span overflows long, it must not become one jump table.
+        CaseLowering lowering(makeLabels({ { -2147483647L - 1, -1 }, { 0, 2147483647L } }));
+
+        check(lowering.getClusters().size() == 2, "full range: two clusters");
+        check(lowering.getClusters()[0].kind == CaseClusterKind::RANGE, "full range: kind");
+    }
+
+    void testNoOverlap()
+    {
+        std::size_t first = 0;
+        std::size_t second = 0;
+        CaseLowering lowering(makeLabels({ { 'a', 'z' }, { '0', '9' }, { 'A', 'Z' } }));
+
+        check(!lowering.findOverlap(first, second), "no overlap");
+    }
+
+    void testOverlap()
+    {
+        std::size_t first = 0;
+        std::size_t second = 0;
+
+        CaseLowering single(makeLabels({ { 1, 1 }, { 2, 2 }, { 1, 1 } }));
+        check(single.findOverlap(first, second), "overlap: same single label");
+        check(single.getLabels()[first].low == 1 && single.getLabels()[second].low == 1, "overlap: labels found");
+
+        // 5 is inside 1..10, which is not the label just before it.
+        CaseLowering nested(makeLabels({ { 1, 10 }, { 3, 3 }, { 5, 5 } }));
+        check(nested.findOverlap(first, second), "overlap: label inside range");
+        check(nested.getLabels()[first].sourceIndex == 0, "overlap: range is the first label");
+
+        CaseLowering touching(makeLabels({ { 1, 10 }, { 10, 20 } }));
+        check(touching.findOverlap(first, second), "overlap: ranges share one value");
+
+        CaseLowering adjacent(makeLabels({ { 1, 10 }, { 11, 20 } }));
+        check(!adjacent.findOverlap(first, second), "overlap: adjacent ranges");
+    }
+}
+
+int main()
+{
+    testSortsLabels();
+    testJumpTable();
+    testBitTest();
+    testSparseLabels();
+    testFullLongRange();
+    testNoOverlap();
+    testOverlap();
+
+    return testResult();
+}
@@ -0,0 +1,10 @@
+program forrange;
+begin
+  for i := 1 to 10 do
+    writeln(1);
+  for i := 2 * 3 downto 0 do
+    writeln(2);
+{$R-}
+  for i := 1 to 10 do
+    writeln(3)
+end.
@@ -0,0 +1,52 @@
+#include <limits>
+#include <memory>
+#include "ast.h"
+#include "unittest.h"
+
+using namespace llvmpascal;
+using namespace llvmpascal::unittest;
+
+namespace
+{
+    ForStatementAST makeLoop(long start, long end, bool downOrder)
+    {
+        TokenLocation loc;
+        return ForStatementAST(loc, "i", std::make_unique<IntegerExprAST>(loc, start),
+                               std::make_unique<IntegerExprAST>(loc, end), downOrder,
+                               std::make_unique<IntegerExprAST>(loc, 0), RangeCheckKind::HOISTED,
+                               ValueRange{ 0, 0 });
+    }
+
+    void testTripCount()
+    {
+        unsigned long tripCount = 0;
+
+        check(makeLoop(1, 10, false).getConstantTripCount(tripCount) && tripCount == 10, "1 to 10");
+        check(makeLoop(10, 1, true).getConstantTripCount(tripCount) && tripCount == 10, "10 downto 1");
+        check(makeLoop(5, 5, false).getConstantTripCount(tripCount) && tripCount == 1, "5 to 5");
+        check(makeLoop(10, 1, false).getConstantTripCount(tripCount) && tripCount == 0, "10 to 1 is empty");
+        check(makeLoop(1, 10, true).getConstantTripCount(tripCount) && tripCount == 0, "1 downto 10 is empty");
+    }
+
+    void testLongRange()
+    {
+        const long minLong = std::numeric_limits<long>::min();
+        const long maxLong = std::numeric_limits<long>::max();
+        unsigned long tripCount = 0;
+
+        check(makeLoop(-maxLong, maxLong, false).getConstantTripCount(tripCount) &&
+              tripCount == std::numeric_limits<unsigned long>::max(), "-maxint to maxint");
+
+        // 2 ** 64 iterations do not fit unsigned long.
+        check(!makeLoop(minLong, maxLong, false).getConstantTripCount(tripCount), "whole long range");
+        check(!makeLoop(maxLong, minLong, true).getConstantTripCount(tripCount), "whole long range downto");
+    }
+}
+
+int main()
+{
+    testTripCount();
+    testLongRange();
+
+    return testResult();
+}
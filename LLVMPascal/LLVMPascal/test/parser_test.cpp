@@ -0,0 +1,53 @@
+#include <string>
+#include <vector>
+#include "parser.h"
+#include "unittest.h"
+
+using namespace llvmpascal;
+using namespace llvmpascal::unittest;
+
+namespace
+{
+    const std::string testDir = LPC_TEST_DIR;
+
+    void testProgramUses()
+    {
+        Scanner scanner(testDir + "/program_uses.pas");
+        Parser parser(scanner);
+        VecExprASTPtr& ast = parser.parse();
+
+        const ProgramAST* program = ast.empty() ? nullptr : dynamic_cast<const ProgramAST*>(ast.front().get());
+        check(program != nullptr, "program is the first AST");
+
+        if (program != nullptr)
+        {
+            check(program->getProgramName() == "p", "program name");
+            check(program->getUsedUnits() == std::vector<std::string>{ "a", "b" }, "program uses a, b");
+        }
+    }
+
+    void testUnitUses()
+    {
+        Scanner scanner(testDir + "/unit_const.pas");
+        Parser parser(scanner);
+        VecExprASTPtr& ast = parser.parse();
+
+        const UnitAST* unit = ast.empty() ? nullptr : dynamic_cast<const UnitAST*>(ast.front().get());
+        check(unit != nullptr, "unit is the first AST");
+
+        if (unit != nullptr)
+        {
+            check(unit->getUnitName() == "g", "unit name");
+            check(unit->getInterfaceUses() == std::vector<std::string>{ "a", "b" }, "interface uses a, b");
+            check(unit->getImplementationUses().empty(), "no implementation uses");
+        }
+    }
+}
+
+int main()
+{
+    testProgramUses();
+    testUnitUses();
+
+    return testResult();
+}
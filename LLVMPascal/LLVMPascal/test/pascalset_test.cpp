@@ -0,0 +1,90 @@
+#include "pascalset.h"
+#include "unittest.h"
+
+using namespace llvmpascal;
+using namespace llvmpascal::unittest;
+
+namespace
+{
+    PascalSet makeSet(int low, int high)
+    {
+        PascalSet set;
+        set.insertRange(low, high);
+        return set;
+    }
+
+    void testMembership()
+    {
+        PascalSet set;
+        check(set.isEmpty() && set.size() == 0, "membership: new set is empty");
+
+        set.insert(0);
+        set.insert(63);
+        set.insert(64);
+        set.insert(255);
+        check(set.size() == 4, "membership: size");
+        check(set.contains(0) && set.contains(63) && set.contains(64) && set.contains(255),
+              "membership: word boundaries");
+        check(!set.contains(1) && !set.contains(62) && !set.contains(65), "membership: other elements");
+
+        // outside 0..255 is never a member and insert ignores it.
+        set.insert(-1);
+        set.insert(256);
+        check(set.size() == 4, "membership: out of range insert");
+        check(!set.contains(-1) && !set.contains(256), "membership: out of range contains");
+    }
+
+    void testInsertRange()
+    {
+        check(makeSet(3, 5).toString() == "[3..5]", "range: 3..5");
+        check(makeSet(5, 3).isEmpty(), "range: low > high is empty");
+        check(makeSet(60, 70).size() == 11, "range: across one word boundary");
+        check(makeSet(-10, 300).size() == 256, "range: clamped to 0..255");
+    }
+
+    void testOperators()
+    {
+        PascalSet lhs = makeSet(1, 10);
+        PascalSet rhs = makeSet(5, 200);
+
+        check((lhs + rhs) == makeSet(1, 200), "union");
+        check((lhs * rhs) == makeSet(5, 10), "intersection");
+        check((lhs - rhs) == makeSet(1, 4), "difference");
+        check((lhs * makeSet(100, 200)).isEmpty(), "disjoint intersection");
+        check(lhs != rhs, "inequality");
+    }
+
+    void testInclusion()
+    {
+        PascalSet small = makeSet(3, 4);
+        PascalSet large = makeSet(1, 128);
+
+        check(small <= large && large >= small, "inclusion");
+        check(!(large <= small) && !(small >= large), "no inclusion");
+        check(small <= small && small >= small, "set includes itself");
+        check(PascalSet() <= small, "empty set is included");
+    }
+
+    void testToString()
+    {
+        PascalSet set;
+        set.insert(1);
+        set.insertRange(3, 5);
+        set.insert(7);
+        set.insert(255);
+
+        check(PascalSet().toString() == "[]", "toString: empty");
+        check(set.toString() == "[1, 3..5, 7, 255]", "toString: members and ranges");
+    }
+}
+
+int main()
+{
+    testMembership();
+    testInsertRange();
+    testOperators();
+    testInclusion();
+    testToString();
+
+    return testResult();
+}
@@ -0,0 +1,4 @@
+program p;
+uses a, b;
+begin
+end.
@@ -0,0 +1,4 @@
+program setrange;
+begin
+  writeln(3 in [300..2, 1..2, 'a'])
+end.
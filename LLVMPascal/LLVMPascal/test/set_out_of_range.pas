@@ -0,0 +1,4 @@
+program setoutofrange;
+begin
+  writeln(3 in [1, 2..256])
+end.
@@ -0,0 +1,5 @@
+unit g;
+interface
+procedure foo;
+implementation
+end.
@@ -0,0 +1,7 @@
+unit g;
+interface
+uses a, b;
+const size = 10;
+implementation
+var x : integer;
+end.
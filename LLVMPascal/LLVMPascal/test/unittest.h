@@ -0,0 +1,41 @@
+#ifndef UNITTEST_H_
+#define UNITTEST_H_
+
+#include <iostream>
+
+namespace llvmpascal
+{
+    // the few helpers our unit tests share. Every test is one executable,
+    // main() runs the checks and returns testResult().
+    namespace unittest
+    {
+        inline int& failureCount()
+        {
+            static int failures = 0;
+            return failures;
+        }
+
+        inline void check(bool condition, const char* what)
+        {
+            if (!condition)
+            {
+                std::cerr << "FAILED: " << what << std::endl;
+                failureCount()++;
+            }
+        }
+
+        // the exit status of the test executable.
+        inline int testResult()
+        {
+            if (failureCount() != 0)
+            {
+                std::cerr << failureCount() << " check(s) failed" << std::endl;
+                return 1;
+            }
+
+            return 0;
+        }
+    }
+}
+
+#endif // unittest.h
@@ -0,0 +1,4 @@
+program writeformat;
+begin
+  writeln(7 div 2, 7 mod 2, 1.5 : 8 : 2, 'x' : 3, 10 : 2 * 3)
+end.
@@ -0,0 +1,4 @@
+program writeprecision;
+begin
+  writeln(15 : 8 : 2)
+end.
@@ -0,0 +1,4 @@
+program writewidth;
+begin
+  writeln(1.5 : 8.0)
+end.
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include "timetrace.h"
+
+namespace llvmpascal
+{
+    bool TimeTracer::enabled_ = false;
+    TimeTracer::Clock::duration TimeTracer::granularity_;
+    TimeTracer::Clock::time_point TimeTracer::beginningOfTime_;
+    std::vector<TimeTracer::Event> TimeTracer::events_;
+    std::map<std::string, TimeTracer::Total> TimeTracer::totals_;
+
+    namespace
+    {
+        long toMicroseconds(TimeTracer::Clock::duration d)
+        {
+            return static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+        }
+
+        // names are our own literals, but detail may contain file names.
+        std::string escapeJSON(const std::string& str)
+        {
+            std::string result;
+
+            for (char c : str)
+            {
+                switch (c)
+                {
+                    case '"':  result += "\\\""; break;
+                    case '\\': result += "\\\\"; break;
+                    case '\n': result += "\\n";  break;
+                    case '\t': result += "\\t";  break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            char buffer[8];
+                            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                            result += buffer;
+                        }
+                        else
+                        {
+                            result += c;
+                        }
+                        break;
+                }
+            }
+
+            return result;
+        }
+    }
+
+    void TimeTracer::enable(long granularityMicroseconds)
+    {
+        enabled_ = true;
+        granularity_ = std::chrono::microseconds(granularityMicroseconds);
+        beginningOfTime_ = Clock::now();
+    }
+
+    void TimeTracer::record(const char* name, const std::string& detail,
+                            Clock::time_point start, Clock::time_point end)
+    {
+        Clock::duration duration = end - start;
+
+        auto iter = totals_.find(name);
+
+        if (iter == totals_.end())
+        {
+            totals_.insert(std::make_pair(std::string(name), Total{ duration, 1 }));
+        }
+        else
+        {
+            iter->second.duration += duration;
+            iter->second.count++;
+        }
+
+        // every getNextToken has one scope, so we only keep the events
+        // which are long enough to be seen in the trace viewer.
+        if (duration >= granularity_)
+        {
+            events_.push_back(Event{ name, detail, start, duration });
+        }
+    }
+
+    // Note: scopes are nested, so the total of one phase contains
+    // the time of the phases called by it (i.e. Parse contains GetNextToken).
+    void TimeTracer::printReport(std::ostream& out)
+    {
+        std::vector<std::pair<std::string, Total>> totals(totals_.begin(), totals_.end());
+        std::sort(totals.begin(), totals.end(),
+                  [](const std::pair<std::string, Total>& lhs, const std::pair<std::string, Total>& rhs)
+                  {
+                      return lhs.second.duration > rhs.second.duration;
+                  });
+
+        out << "===-------------------------------------------------------------------------===\n"
+            << "                          lpc compile time report\n"
+            << "===-------------------------------------------------------------------------===\n"
+            << "  Total (ms)      Count    Average (us)   Name\n";
+
+        for (const auto& total : totals)
+        {
+            double milliseconds = toMicroseconds(total.second.duration) / 1000.0;
+            double average = static_cast<double>(toMicroseconds(total.second.duration)) / total.second.count;
+
+            out << "  " << std::fixed << std::setprecision(3) << std::setw(10) << milliseconds
+                << "  " << std::setw(9) << total.second.count
+                << "  " << std::setw(14) << average
+                << "   " << total.first << '\n';
+        }
+
+        out.flush();
+    }
+
+    // Chrome trace event format: one complete event ("ph":"X") per scope.
+    bool TimeTracer::writeTrace(const std::string& fileName)
+    {
+        std::ofstream output(fileName);
+
+        if (!output)
+        {
+            return false;
+        }
+
+        output << "{\"traceEvents\":[";
+
+        bool first = true;
+
+        for (const auto& event : events_)
+        {
+            output << (first ? "\n" : ",\n")
+                   << "{\"pid\":1,\"tid\":0,\"ph\":\"X\""
+                   << ",\"ts\":" << toMicroseconds(event.start - beginningOfTime_)
+                   << ",\"dur\":" << toMicroseconds(event.duration)
+                   << ",\"name\":\"" << escapeJSON(event.name) << "\"";
+
+            if (!event.detail.empty())
+            {
+                output << ",\"args\":{\"detail\":\"" << escapeJSON(event.detail) << "\"}";
+            }
+
+            output << "}";
+            first = false;
+        }
+
+        output << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        return static_cast<bool>(output);
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef TIMETRACE_H_
+#define TIMETRACE_H_
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace llvmpascal
+{
+    // Compile phase timing. It is very like clang's -ftime-report and
+    // -ftime-trace: every TimeTraceScope adds its duration to a per-name
+    // total for the report table, and scopes longer than the granularity
+    // are also kept as events for the Chrome trace-event JSON file, which
+    // can be opened in chrome://tracing or https://ui.perfetto.dev.
+    //
+    // When tracing is disabled, a scope costs one check of a static flag.
+    class TimeTracer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static void      enable(long granularityMicroseconds);
+        static bool      isEnabled();
+        static void      record(const char* name, const std::string& detail,
+                                Clock::time_point start, Clock::time_point end);
+        static void      printReport(std::ostream& out);
+        static bool      writeTrace(const std::string& fileName);
+
+    private:
+        struct Event
+        {
+            std::string       name;
+            std::string       detail;
+            Clock::time_point start;
+            Clock::duration   duration;
+        };
+
+        struct Total
+        {
+            Clock::duration   duration;
+            long              count;
+        };
+
+        static bool                          enabled_;
+        static Clock::duration               granularity_;
+        static Clock::time_point             beginningOfTime_;
+        static std::vector<Event>            events_;
+        static std::map<std::string, Total>  totals_;
+    };
+
+    class TimeTraceScope
+    {
+    public:
+        explicit         TimeTraceScope(const char* name);
+        TimeTraceScope(const char* name, const std::string& detail);
+        ~TimeTraceScope();
+
+        TimeTraceScope(const TimeTraceScope&) = delete;
+        TimeTraceScope&  operator=(const TimeTraceScope&) = delete;
+
+    private:
+        const char*                name_;
+        std::string                detail_;
+        TimeTracer::Clock::time_point start_;
+    };
+
+    inline bool TimeTracer::isEnabled()
+    {
+        return enabled_;
+    }
+
+    inline TimeTraceScope::TimeTraceScope(const char* name)
+        : name_(name)
+    {
+        if (TimeTracer::isEnabled())
+        {
+            start_ = TimeTracer::Clock::now();
+        }
+    }
+
+    inline TimeTraceScope::TimeTraceScope(const char* name, const std::string& detail)
+        : name_(name)
+    {
+        if (TimeTracer::isEnabled())
+        {
+            detail_ = detail;
+            start_ = TimeTracer::Clock::now();
+        }
+    }
+
+    inline TimeTraceScope::~TimeTraceScope()
+    {
+        if (TimeTracer::isEnabled())
+        {
+            TimeTracer::record(name_, detail_, start_, TimeTracer::Clock::now());
+        }
+    }
+}
+
+#endif // timetrace.h
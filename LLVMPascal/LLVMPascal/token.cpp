@@ -10,12 +10,13 @@
 * License: BSD
 *********************************/
 
+#include <utility>
 #include "token.h"
+#include "memstats.h"
 
 
 namespace llvmpascal
 {
-
     TokenLocation::TokenLocation(const std::string& fileName, int line, int column)
         : fileName_(fileName), line_(line), column_(column)
     {}
@@ -33,32 +34,109 @@ namespace llvmpascal
 
 
     Token::Token() : type_(TokenType::UNKNOWN), value_(TokenValue::UNRESERVED),
-        location_(std::string(""), 0, 0), name_(""), symbolPrecedence_(-1)
-    {}
+        location_(std::string(""), 0, 0), name_(""), symbolPrecedence_(-1),
+        intValue_(0), realValue_(0.0)
+    {
+        MemoryStats::allocate(MemoryCategory::TOKEN, memoryBytes());
+    }
 
     Token::Token(TokenType type, TokenValue value, const TokenLocation& location,
                  std::string name, int symbolPrecedence)
-        : type_(type), value_(value), location_(location), name_(name),
-          symbolPrecedence_(symbolPrecedence)
-    {}
+        : type_(type), value_(value), location_(location), name_(std::move(name)),
+          symbolPrecedence_(symbolPrecedence), intValue_(0), realValue_(0.0)
+    {
+        MemoryStats::allocate(MemoryCategory::TOKEN, memoryBytes());
+    }
 
     Token::Token(TokenType type, TokenValue value, const TokenLocation& location,
                  const std::string& strValue, std::string name)
         : type_(type), value_(value), location_(location),
-          name_(name), symbolPrecedence_(-1), strValue_(strValue)
-    {}
+          name_(std::move(name)), symbolPrecedence_(-1), intValue_(0), realValue_(0.0),
+          strValue_(strValue)
+    {
+        MemoryStats::allocate(MemoryCategory::TOKEN, memoryBytes());
+    }
 
     Token::Token(TokenType type, TokenValue value, const TokenLocation& location,
                  long intValue, std::string name)
         : type_(type), value_(value), location_(location),
-          name_(name), symbolPrecedence_(-1), intValue_(intValue)
-    {}
+          name_(std::move(name)), symbolPrecedence_(-1), intValue_(intValue), realValue_(0.0)
+    {
+        MemoryStats::allocate(MemoryCategory::TOKEN, memoryBytes());
+    }
 
     Token::Token(TokenType type, TokenValue value, const TokenLocation& location,
                  double realValue, std::string name)
         : type_(type), value_(value), location_(location),
-          name_(name), symbolPrecedence_(-1), realValue_(realValue)
-    {}
+          name_(std::move(name)), symbolPrecedence_(-1), intValue_(0), realValue_(realValue)
+    {
+        MemoryStats::allocate(MemoryCategory::TOKEN, memoryBytes());
+    }
+
+    Token::Token(const Token& other)
+        : type_(other.type_), value_(other.value_), location_(other.location_), name_(other.name_),
+          symbolPrecedence_(other.symbolPrecedence_), intValue_(other.intValue_),
+          realValue_(other.realValue_), strValue_(other.strValue_)
+    {
+        MemoryStats::allocate(MemoryCategory::TOKEN, memoryBytes());
+    }
+
+    Token::Token(Token&& other)
+        : type_(other.type_), value_(other.value_), location_(std::move(other.location_)),
+          symbolPrecedence_(other.symbolPrecedence_), intValue_(other.intValue_),
+          realValue_(other.realValue_)
+    {
+        // the string buffers move from other to us, so other becomes smaller.
+        const std::size_t otherBytes = other.memoryBytes();
+        name_ = std::move(other.name_);
+        strValue_ = std::move(other.strValue_);
+        MemoryStats::allocate(MemoryCategory::TOKEN, memoryBytes());
+        MemoryStats::resize(MemoryCategory::TOKEN, otherBytes, other.memoryBytes());
+    }
+
+    Token& Token::operator=(const Token& other)
+    {
+        const std::size_t oldBytes = memoryBytes();
+        location_ = other.location_;
+        name_ = other.name_;
+        strValue_ = other.strValue_;
+        symbolPrecedence_ = other.symbolPrecedence_;
+        intValue_ = other.intValue_;
+        realValue_ = other.realValue_;
+        type_ = other.type_;
+        value_ = other.value_;
+        MemoryStats::resize(MemoryCategory::TOKEN, oldBytes, memoryBytes());
+        return *this;
+    }
+
+    Token& Token::operator=(Token&& other)
+    {
+        // std::string may hand our old buffers to other, so count both sides again.
+        const std::size_t oldBytes = memoryBytes();
+        const std::size_t otherBytes = other.memoryBytes();
+        location_ = std::move(other.location_);
+        name_ = std::move(other.name_);
+        strValue_ = std::move(other.strValue_);
+        symbolPrecedence_ = other.symbolPrecedence_;
+        intValue_ = other.intValue_;
+        realValue_ = other.realValue_;
+        type_ = other.type_;
+        value_ = other.value_;
+        MemoryStats::resize(MemoryCategory::TOKEN, oldBytes, memoryBytes());
+        MemoryStats::resize(MemoryCategory::TOKEN, otherBytes, other.memoryBytes());
+        return *this;
+    }
+
+    Token::~Token()
+    {
+        MemoryStats::deallocate(MemoryCategory::TOKEN, memoryBytes());
+    }
+
+    std::size_t Token::memoryBytes() const
+    {
+        return sizeof(Token) + MemoryStats::stringHeapBytes(name_) +
+               MemoryStats::stringHeapBytes(strValue_);
+    }
 
     std::string Token::tokenTypeDescription() const
     {
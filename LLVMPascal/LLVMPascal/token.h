@@ -70,6 +70,12 @@ namespace llvmpascal
         WITH,
         IN,
 
+        // units, Turbo Pascal / Free Pascal extension
+        UNIT,
+        INTERFACE,
+        IMPLEMENTATION,
+        USES,
+
         // I/O routine
         WRITE,
         WRITELN,
@@ -150,11 +156,19 @@ namespace llvmpascal
         Token(TokenType type, TokenValue value, const TokenLocation& location,
               double realValue, std::string name);
 
+        // tokens are counted by -fmem-report for as long as they live,
+        // so copies, moves and assignments have to keep the counter right.
+        Token(const Token& other);
+        Token(Token&& other);
+        Token& operator=(const Token& other);
+        Token& operator=(Token&& other);
+        ~Token();
+
         // get token information
         TokenType getTokenType() const;
         TokenValue getTokenValue() const;
         const TokenLocation& getTokenLocation() const;
-        std::string getTokenName() const;
+        const std::string& getTokenName() const;
 
         // + - * / and so on.
         int getSymbolPrecedence() const;
@@ -162,7 +176,7 @@ namespace llvmpascal
         // get constant values of token
         long getIntValue() const;
         double getRealValue() const;
-        std::string getStringValue() const;
+        const std::string& getStringValue() const;
 
         // output debug information.
         // here output token location, value and type.
@@ -172,25 +186,26 @@ namespace llvmpascal
 
         // more exact function for getting identifier name.
         // Its essential heart is just getTokenName.
-        std::string getIdentifierName() const;
+        const std::string& getIdentifierName() const;
 
         std::string tokenTypeDescription() const;
         std::string toString() const;
 
+      private:
+        // bytes this token accounts for in the TOKEN memory category.
+        std::size_t memoryBytes() const;
+
       private:
         TokenType       type_;
         TokenValue      value_;
         TokenLocation   location_;
         std::string     name_;
         int             symbolPrecedence_;
-        
 
         // const values of token
         long            intValue_;
         double          realValue_;
         std::string     strValue_;
-
-
     };
 
     inline TokenType Token::getTokenType() const
@@ -203,7 +218,7 @@ namespace llvmpascal
         return value_;
     }
 
-    inline std::string Token::getTokenName() const
+    inline const std::string& Token::getTokenName() const
     {
         return name_;
     }
@@ -223,7 +238,7 @@ namespace llvmpascal
         return realValue_;
     }
 
-    inline std::string Token::getStringValue() const
+    inline const std::string& Token::getStringValue() const
     {
         return strValue_;
     }
@@ -233,7 +248,7 @@ namespace llvmpascal
         return symbolPrecedence_;
     }
 
-    inline std::string Token::getIdentifierName() const
+    inline const std::string& Token::getIdentifierName() const
     {
         assert(type_ == TokenType::IDENTIFIER && "Token type should be identifier.");
         return name_;